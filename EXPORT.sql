@@ -12,6 +12,10 @@ CREATE OR REPLACE PACKAGE export AS
   ** Date            Name                 Description
   **------------------------------------------------------------------------
   ** 13/07/2022      Ian Bond           Program created
+  ** 18/10/2026      agent              Add order_batch to export orders imported since a given ORDID
+  ** 18/10/2026      agent              Add applog and import_errors to export the logs for the logq tool
+  ** 18/10/2026      agent              Share one cursor between orders and order_batch in write_orders
+  ** 18/10/2026      agent              Add p_after_recid to applog and import_errors
   **   
   */
   
@@ -64,6 +68,62 @@ CREATE OR REPLACE PACKAGE export AS
   */
   FUNCTION orders RETURN BOOLEAN;
 
+  /*
+  ** order_batch - export orders added since a given order to a CSV file
+  **
+  ** Writes the orders with an ORDID greater than p_after_ordid, in the same
+  ** layout as the orders export. Used to pass each batch of imported orders
+  ** to the salesagg sales aggregates program, which reports the ORDID to pass.
+  **
+  ** IN
+  **   p_after_ordid  - Export orders with an ORDID greater than this
+  ** RETURN
+  **   BOOLEAN   TRUE if data exported OK, FALSE if failed
+  ** EXCEPTIONS
+  **   <exception_name1>      - <brief description>
+  */
+  FUNCTION order_batch (
+    p_after_ordid IN ord.ordid%TYPE
+  ) RETURN BOOLEAN;
+
+  /*
+  ** applog - export the application log to a CSV file
+  **
+  ** Writes the APPLOG rows with a RECID greater than p_after_recid, one line
+  ** per row, for the logq log query tool. Pass the APPLOG RECID reported by
+  ** logq watermark. Rows above it that committed after a higher RECID are
+  ** exported again until they settle, logq skips the ones it has loaded.
+  **
+  ** IN
+  **   p_after_recid  - Export rows with a RECID greater than this, NULL for every row
+  ** RETURN
+  **   BOOLEAN   TRUE if data exported OK, FALSE if failed
+  ** EXCEPTIONS
+  **   <exception_name1>      - <brief description>
+  */
+  FUNCTION applog (
+    p_after_recid IN applog.recid%TYPE
+  ) RETURN BOOLEAN;
+
+  /*
+  ** import_errors - export the data import errors to a CSV file
+  **
+  ** Writes the IMPORTERROR rows with a RECID greater than p_after_recid, one
+  ** line per row, for the logq log query tool. Pass the IMPORTERROR RECID
+  ** reported by logq watermark. Rows above it that committed after a higher
+  ** RECID are exported again until they settle, logq skips the ones it has loaded.
+  **
+  ** IN
+  **   p_after_recid  - Export rows with a RECID greater than this, NULL for every row
+  ** RETURN
+  **   BOOLEAN   TRUE if data exported OK, FALSE if failed
+  ** EXCEPTIONS
+  **   <exception_name1>      - <brief description>
+  */
+  FUNCTION import_errors (
+    p_after_recid IN importerror.recid%TYPE
+  ) RETURN BOOLEAN;
+
 END export;
 /
 
@@ -82,6 +142,10 @@ CREATE OR REPLACE PACKAGE BODY export AS
   ** Date            Name                 Description
   **------------------------------------------------------------------------
   ** 13/07/2022      Ian Bond           Program created
+  ** 18/10/2026      agent              Add order_batch to export orders imported since a given ORDID
+  ** 18/10/2026      agent              Add applog and import_errors to export the logs for the logq tool
+  ** 18/10/2026      agent              Share one cursor between orders and order_batch in write_orders
+  ** 18/10/2026      agent              Add p_after_recid to applog and import_errors
   **   
   */
 
@@ -90,61 +154,47 @@ CREATE OR REPLACE PACKAGE BODY export AS
   ** Private functions and procedures
   */
 
-
   /*
-  ** Public functions and procedures
+  ** csv_text - enclose free text in double quotes for a CSV file
+  **
+  ** Double any quotes within the text, and replace line breaks with spaces
+  ** so that each row is written on a single line.
+  **
+  ** IN
+  **   p_text         - Text to be written to the CSV file
+  ** RETURN
+  **   VARCHAR2  The quoted text
   */
-
-
-  FUNCTION demo
-    RETURN BOOLEAN 
+  FUNCTION csv_text (
+    p_text IN VARCHAR2
+  ) RETURN VARCHAR2
   IS
-    --
-    CURSOR demo_cur IS
-      SELECT to_char(D.entry_date,'DD/MM/YYYY') entry_date,
-             D.memorandum
-      FROM   demo D;
-    --
-    rec_demo demo_cur%ROWTYPE;
-    l_file_id utl_file.file_type;
-    l_filename plsql_constants.filenamelength_t;
-    l_rec plsql_constants.maxvarchar2_t;
   BEGIN
-    -- Create the CSV file named: demo_YYYMMDD.csv
-    l_filename := 'demo_'||to_char(SYSDATE,'YYMMDD')||'.csv';
-    l_file_id := utl_file.fopen(gc_export_directory, l_filename, 'W');
-
-    -- Write CSV Header
-    l_rec := '"Entry Date","Memorandum"';
-    utl_file.put_line(l_file_id,l_rec);
+    RETURN gc_quote
+        || REPLACE(REPLACE(REPLACE(p_text, gc_quote, gc_quote || gc_quote), CHR(13), ' '), CHR(10), ' ')
+        || gc_quote;
+  END csv_text;
 
-    -- Write data to CSV file
-    -- Separate each field with a delimiter
-    -- Enclose strings in double quotes
-    --
-    OPEN demo_cur;
-    LOOP
-      FETCH demo_cur INTO rec_demo;
-      EXIT WHEN demo_cur%NOTFOUND;
-      l_rec :=                            rec_demo.entry_date
-               || gc_delim || gc_quote || rec_demo.memorandum     || gc_quote 
-               ;
-      utl_file.put_line(l_file_id,l_rec);
-    END LOOP;
-    CLOSE demo_cur;
-    utl_file.fclose(l_file_id);
-    RETURN TRUE;
-  EXCEPTION
-    WHEN OTHERS THEN
-      util_admin.log_message('Unexpected Error',SQLERRM,'EXPORT.DEMO','B',gc_error);
-      RETURN FALSE;
-  END demo;
-
-  FUNCTION orders 
-    RETURN BOOLEAN 
+  /*
+  ** write_orders - write orders to a CSV file in the orders export layout
+  **
+  ** Shared by orders and order_batch so that both files have the same layout.
+  **
+  ** IN
+  **   p_filename     - Name of the CSV file in the export directory
+  **   p_after_ordid  - Write orders with an ORDID greater than this, NULL for all orders
+  ** EXCEPTIONS
+  **   Any error raised writing the file is passed to the caller
+  */
+  PROCEDURE write_orders (
+    p_filename    IN VARCHAR2,
+    p_after_ordid IN ord.ordid%TYPE
+  )
   IS
     --
-    CURSOR ord_cur IS
+    CURSOR ord_cur (
+      p_ordid ord.ordid%TYPE
+    ) IS
       SELECT O.ordid,
              NVL(O.ordref,'No ref') ordref,
              to_char(O.orderdate,'DD/MM/YYYY') orderdate,
@@ -165,7 +215,8 @@ CREATE OR REPLACE PACKAGE BODY export AS
              emp E,
              item I,
              product P
-      WHERE  C.custid = O.custid
+      WHERE  (p_ordid IS NULL OR O.ordid > p_ordid)
+      AND    C.custid = O.custid
       AND    E.empno = C.repid
       AND    I.ordid (+) = O.ordid
       AND    P.prodid (+) = I.prodid
@@ -173,12 +224,9 @@ CREATE OR REPLACE PACKAGE BODY export AS
     --
     rec_ord ord_cur%ROWTYPE;
     l_file_id utl_file.file_type;
-    l_filename plsql_constants.filenamelength_t;
     l_rec plsql_constants.maxvarchar2_t;
   BEGIN
-    -- Create the CSV file named: orders_YYYMMDD.csv
-    l_filename := 'orders_'||to_char(SYSDATE,'YYMMDD')||'.csv';
-    l_file_id := utl_file.fopen(gc_export_directory, l_filename, 'W');
+    l_file_id := utl_file.fopen(gc_export_directory, p_filename, 'W');
 
     -- Write CSV Header
     l_rec := '"Order ID","Order Ref","Order Date","Ship Date","Comm Plan","Total","Customer ID","Customer Name","Sales Rep","Item","Product ID","Description","Price","Qty","Item Total"';
@@ -188,7 +236,7 @@ CREATE OR REPLACE PACKAGE BODY export AS
     -- Separate each field with a delimiter
     -- Enclose strings in double quotes
     --
-    OPEN ord_cur;
+    OPEN ord_cur(p_after_ordid);
     LOOP
       FETCH ord_cur INTO rec_ord;
       EXIT WHEN ord_cur%NOTFOUND;
@@ -212,6 +260,73 @@ CREATE OR REPLACE PACKAGE BODY export AS
     END LOOP;
     CLOSE ord_cur;
     utl_file.fclose(l_file_id);
+  EXCEPTION
+    WHEN OTHERS THEN
+      IF ord_cur%ISOPEN THEN
+        CLOSE ord_cur;
+      END IF;
+      IF utl_file.is_open(l_file_id) THEN
+        utl_file.fclose(l_file_id);
+      END IF;
+      RAISE;
+  END write_orders;
+
+
+  /*
+  ** Public functions and procedures
+  */
+
+
+  FUNCTION demo
+    RETURN BOOLEAN 
+  IS
+    --
+    CURSOR demo_cur IS
+      SELECT to_char(D.entry_date,'DD/MM/YYYY') entry_date,
+             D.memorandum
+      FROM   demo D;
+    --
+    rec_demo demo_cur%ROWTYPE;
+    l_file_id utl_file.file_type;
+    l_filename plsql_constants.filenamelength_t;
+    l_rec plsql_constants.maxvarchar2_t;
+  BEGIN
+    -- Create the CSV file named: demo_YYYMMDD.csv
+    l_filename := 'demo_'||to_char(SYSDATE,'YYMMDD')||'.csv';
+    l_file_id := utl_file.fopen(gc_export_directory, l_filename, 'W');
+
+    -- Write CSV Header
+    l_rec := '"Entry Date","Memorandum"';
+    utl_file.put_line(l_file_id,l_rec);
+
+    -- Write data to CSV file
+    -- Separate each field with a delimiter
+    -- Enclose strings in double quotes
+    --
+    OPEN demo_cur;
+    LOOP
+      FETCH demo_cur INTO rec_demo;
+      EXIT WHEN demo_cur%NOTFOUND;
+      l_rec :=                            rec_demo.entry_date
+               || gc_delim || gc_quote || rec_demo.memorandum     || gc_quote 
+               ;
+      utl_file.put_line(l_file_id,l_rec);
+    END LOOP;
+    CLOSE demo_cur;
+    utl_file.fclose(l_file_id);
+    RETURN TRUE;
+  EXCEPTION
+    WHEN OTHERS THEN
+      util_admin.log_message('Unexpected Error',SQLERRM,'EXPORT.DEMO','B',gc_error);
+      RETURN FALSE;
+  END demo;
+
+  FUNCTION orders 
+    RETURN BOOLEAN 
+  IS
+  BEGIN
+    -- Create the CSV file named: orders_YYYMMDD.csv
+    write_orders('orders_'||to_char(SYSDATE,'YYMMDD')||'.csv', NULL);
     RETURN TRUE;
   EXCEPTION
     WHEN OTHERS THEN
@@ -219,5 +334,127 @@ CREATE OR REPLACE PACKAGE BODY export AS
       RETURN FALSE;
   END orders;
 
+  FUNCTION order_batch (
+    p_after_ordid IN ord.ordid%TYPE
+  ) RETURN BOOLEAN 
+  IS
+  BEGIN
+    -- Create the CSV file named: order_batch_<ORDID>.csv
+    write_orders('order_batch_'||to_char(NVL(p_after_ordid,0))||'.csv', NVL(p_after_ordid,0));
+    RETURN TRUE;
+  EXCEPTION
+    WHEN OTHERS THEN
+      util_admin.log_message('Unexpected Error',SQLERRM,'EXPORT.ORDER_BATCH','B',gc_error);
+      RETURN FALSE;
+  END order_batch;
+
+  FUNCTION applog (
+    p_after_recid IN applog.recid%TYPE
+  ) RETURN BOOLEAN 
+  IS
+    --
+    CURSOR applog_cur IS
+      SELECT L.recid,
+             to_char(L.logged_at,'DD/MM/YYYY HH24:MI:SS') logged_at,
+             L.user_name,
+             L.program_name,
+             L.severity,
+             L.message,
+             L.applog_sqlerrm
+      FROM   applog L
+      WHERE  L.recid > NVL(p_after_recid,0)
+      ORDER BY L.recid;
+    --
+    rec_applog applog_cur%ROWTYPE;
+    l_file_id utl_file.file_type;
+    l_filename plsql_constants.filenamelength_t;
+    l_rec plsql_constants.maxvarchar2_t;
+  BEGIN
+    -- Create the CSV file named: applog_YYMMDD.csv
+    l_filename := 'applog_'||to_char(SYSDATE,'YYMMDD')||'.csv';
+    l_file_id := utl_file.fopen(gc_export_directory, l_filename, 'W', 32767);
+
+    -- Write CSV Header
+    l_rec := '"Rec ID","Logged At","User","Program","Severity","Message","SQLERRM"';
+    utl_file.put_line(l_file_id,l_rec);
+
+    OPEN applog_cur;
+    LOOP
+      FETCH applog_cur INTO rec_applog;
+      EXIT WHEN applog_cur%NOTFOUND;
+      l_rec :=                            rec_applog.recid 
+               || gc_delim ||             rec_applog.logged_at
+               || gc_delim || gc_quote || rec_applog.user_name     || gc_quote 
+               || gc_delim || gc_quote || rec_applog.program_name  || gc_quote 
+               || gc_delim || gc_quote || rec_applog.severity      || gc_quote 
+               || gc_delim || csv_text(rec_applog.message)
+               || gc_delim || csv_text(rec_applog.applog_sqlerrm)
+               ;
+      utl_file.put_line(l_file_id,l_rec);
+    END LOOP;
+    CLOSE applog_cur;
+    utl_file.fclose(l_file_id);
+    RETURN TRUE;
+  EXCEPTION
+    WHEN OTHERS THEN
+      util_admin.log_message('Unexpected Error',SQLERRM,'EXPORT.APPLOG','B',gc_error);
+      RETURN FALSE;
+  END applog;
+
+  FUNCTION import_errors (
+    p_after_recid IN importerror.recid%TYPE
+  ) RETURN BOOLEAN 
+  IS
+    --
+    CURSOR error_cur IS
+      SELECT E.recid,
+             to_char(E.error_time,'DD/MM/YYYY HH24:MI:SS') error_time,
+             E.user_name,
+             E.filename,
+             E.key_value,
+             E.error_message,
+             E.error_data,
+             E.import_sqlerrm
+      FROM   importerror E
+      WHERE  E.recid > NVL(p_after_recid,0)
+      ORDER BY E.recid;
+    --
+    rec_error error_cur%ROWTYPE;
+    l_file_id utl_file.file_type;
+    l_filename plsql_constants.filenamelength_t;
+    l_rec plsql_constants.maxvarchar2_t;
+  BEGIN
+    -- Create the CSV file named: importerror_YYMMDD.csv
+    l_filename := 'importerror_'||to_char(SYSDATE,'YYMMDD')||'.csv';
+    l_file_id := utl_file.fopen(gc_export_directory, l_filename, 'W', 32767);
+
+    -- Write CSV Header
+    l_rec := '"Rec ID","Error Time","User","Filename","Key Value","Message","Data","SQLERRM"';
+    utl_file.put_line(l_file_id,l_rec);
+
+    OPEN error_cur;
+    LOOP
+      FETCH error_cur INTO rec_error;
+      EXIT WHEN error_cur%NOTFOUND;
+      l_rec :=                            rec_error.recid 
+               || gc_delim ||             rec_error.error_time
+               || gc_delim || gc_quote || rec_error.user_name     || gc_quote 
+               || gc_delim || csv_text(rec_error.filename)
+               || gc_delim || csv_text(rec_error.key_value)
+               || gc_delim || csv_text(rec_error.error_message)
+               || gc_delim || csv_text(rec_error.error_data)
+               || gc_delim || csv_text(rec_error.import_sqlerrm)
+               ;
+      utl_file.put_line(l_file_id,l_rec);
+    END LOOP;
+    CLOSE error_cur;
+    utl_file.fclose(l_file_id);
+    RETURN TRUE;
+  EXCEPTION
+    WHEN OTHERS THEN
+      util_admin.log_message('Unexpected Error',SQLERRM,'EXPORT.IMPORT_ERRORS','B',gc_error);
+      RETURN FALSE;
+  END import_errors;
+
 END export;
 /
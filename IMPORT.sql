@@ -12,6 +12,8 @@ CREATE OR REPLACE PACKAGE import AS
   ** Date            Name                 Description
   **------------------------------------------------------------------------
   ** 24/06/2022      Ian Bond             Program created
+  ** 18/10/2026      agent                Add ord_stage, ord_valid_shard and ord_commit to import order
+  **                                      files with the validation split into shards run at the same time
   **   
   */
   
@@ -42,6 +44,9 @@ CREATE OR REPLACE PACKAGE import AS
   e_ordid_value_error EXCEPTION;
   PRAGMA EXCEPTION_INIT (e_ordid_value_error,-20003);
 
+  e_file_not_staged EXCEPTION;
+  PRAGMA EXCEPTION_INIT (e_file_not_staged,-20004);
+
  
   /*
   ** Public functions and procedures
@@ -139,15 +144,98 @@ CREATE OR REPLACE PACKAGE import AS
   **
   ** IN
   **   p_filename      - Name of file being imported
+  **   p_fileid        - FILEID of the file on IMPORTCSV if it has already been loaded and
+  **                     validated by ord_stage and ord_valid_shard, called from ord_commit.
+  **                     NULL to load and validate the file as above.
   ** RETURN
   **   BOOLEAN   Returns TRUE if all data imported successfully, otherwise FALSE
   ** EXCEPTIONS
   **   <exception_name1>      - <brief description>
   */
   FUNCTION ord_imp (
+    p_filename IN VARCHAR2,
+    p_fileid   IN importcsv.fileid%TYPE DEFAULT NULL
+  ) RETURN BOOLEAN;
+
+  /*
+  ** Sharded order import
+  **
+  ** import_order.bat imports a batch of order files in three steps, so that the
+  ** validation, which takes most of the time, runs in several sessions at once:
+  **  1. ord_stage loads each file into IMPORTCSV, in the order the files were found.
+  **  2. ord_valid_shard is run in one session per shard, all at the same time. The rows
+  **     of every staged file are split into shards by a hash of ORDREF, so all the items
+  **     of an order are validated in the same shard.
+  **  3. ord_commit imports each file in turn, in the order they were staged, so ORDIDs
+  **     are given out in file and row order as ord_imp does one file at a time.
+  **
+  ** IMPORTSHARD records the staged files and the result of each shard for each file.
+  ** A file is imported whole or not at all, and moved to the processed or error
+  ** directory, as ord_imp does. The IMPORTERROR rows are the same as ord_imp records,
+  ** except that the shards write them at the same time so their RECIDs are not in row
+  ** order, and an ORDREF imported by an earlier file in the batch is only reported as
+  ** a duplicate if the shards found no other error in the file.
+  */
+
+  /*
+  ** ord_stage - Load an order CSV file into the staging table for a sharded import
+  **
+  ** Loads the file in DATA_IN into IMPORTCSV with UTIL_FILE.LOAD_CSV and records it
+  ** on IMPORTSHARD, ready for ord_valid_shard and ord_commit.
+  **
+  ** IN
+  **   p_filename      - Name of file being imported
+  ** RETURN
+  **   BOOLEAN   Returns TRUE if the file was staged, otherwise FALSE
+  ** EXCEPTIONS
+  **   e_file_not_found       - File not in DATA_IN, logged on IMPORTERROR
+  */
+  FUNCTION ord_stage (
     p_filename IN VARCHAR2
   ) RETURN BOOLEAN;
 
+  /*
+  ** ord_valid_shard - Validate one shard of the staged order files
+  **
+  ** Runs the ord_valid checks on the rows of every staged file that hash to p_shard,
+  ** recording errors on IMPORTERROR, and records the result for each file on
+  ** IMPORTSHARD. A row with no ORDREF belongs to the order before it, as in ord_imp.
+  **
+  ** IN
+  **   p_shard         - Shard to validate, 0 to p_shards - 1
+  **   p_shards        - Number of shards the batch is split into
+  ** RETURN
+  **   BOOLEAN   Returns TRUE if every row in the shard is valid, otherwise FALSE
+  ** EXCEPTIONS
+  **   <exception_name1>      - <brief description>
+  */
+  FUNCTION ord_valid_shard (
+    p_shard  IN NUMBER,
+    p_shards IN NUMBER
+  ) RETURN BOOLEAN;
+
+  /*
+  ** ord_commit - Import a staged order file once every shard has validated it
+  **
+  ** If every shard found the file valid, checks no ORDREF in it has been imported
+  ** by an earlier file in the batch, then inserts the orders into ORD and ITEM with
+  ** ord_imp and moves the file to the processed directory. Otherwise deletes the
+  ** staged rows and moves the file to the error directory.
+  **
+  ** IN
+  **   p_filename      - Name of file being imported
+  **   p_shards        - Number of shards the batch was validated in
+  ** RETURN
+  **   BOOLEAN   Returns TRUE if all data imported successfully, otherwise FALSE
+  ** EXCEPTIONS
+  **   e_file_not_staged      - ord_stage did not load the file
+  **   e_invalid_data         - Errors found, file moved to the error directory
+  */
+  FUNCTION ord_commit (
+    p_filename IN VARCHAR2,
+    p_shards   IN NUMBER
+  ) RETURN BOOLEAN;
+
 END import;
 /
 
@@ -167,6 +255,8 @@ CREATE OR REPLACE PACKAGE BODY import AS
   ** 24/06/2022      Ian Bond             Program created
   ** 05/03/2025      Ian Bond             ord_imp: use shorthand to assign ordid_seq.NEXTVAL
   **                                      to l_ordid
+  ** 18/10/2026      agent                Add ord_stage, ord_valid_shard and ord_commit to import order
+  **                                      files with the validation split into shards run at the same time
   */
 
 
@@ -415,20 +505,29 @@ CREATE OR REPLACE PACKAGE BODY import AS
   ** Validate order CSV data in staging table
   ** Record all errors found in IMPORTERROR table.
   **
+  ** When called by ord_valid_shard only the rows whose order has an ORDREF that hashes
+  ** to p_shard are validated. A row with no ORDREF belongs to the order before it.
+  **
   ** IN
   **   p_fileid      - Identifies file being imported
+  **   p_shard       - Shard to validate, 0 to p_shards - 1
+  **   p_shards      - Number of shards, 1 to validate every row
   ** RETURN
   **   BOOLEAN   Returns TRUE if all validated OK, otherwise FALSE
   ** EXCEPTIONS
   **   <exception_name1>      - <brief description>
   */
   FUNCTION ord_valid (
-    p_fileid IN importcsv.fileid%TYPE
+    p_fileid IN importcsv.fileid%TYPE,
+    p_shard  IN NUMBER DEFAULT 0,
+    p_shards IN NUMBER DEFAULT 1
   ) RETURN BOOLEAN IS
     -- Cursors
     --
     CURSOR csv_cur (
-      p_fileid importcsv.fileid%TYPE
+      p_fileid importcsv.fileid%TYPE,
+      p_shard  NUMBER,
+      p_shards NUMBER
     ) IS
     SELECT
       recid,
@@ -441,6 +540,25 @@ CREATE OR REPLACE PACKAGE BODY import AS
     WHERE
         fileid = p_fileid
       AND substr(csv_rec, 1, 9) <> '"Ord Ref"' -- Ignore header
+      AND ( p_shards = 1
+         OR recid IN (
+              SELECT
+                s.recid
+              FROM
+                (
+                  -- Carry the ORDREF forward to rows without one, as ord_imp does
+                  SELECT
+                    c.recid,
+                    LAST_VALUE(util_string.get_field(c.csv_rec, 1, ',') IGNORE NULLS)
+                      OVER (ORDER BY c.recid) AS order_ref
+                  FROM
+                    importcsv c
+                  WHERE
+                      c.fileid = p_fileid
+                    AND substr(c.csv_rec, 1, 9) <> '"Ord Ref"'
+                ) s
+              WHERE
+                ora_hash(nvl(s.order_ref, ' '), p_shards - 1) = p_shard ) )
     FOR UPDATE;
     --
     -- Local Constants
@@ -477,7 +595,7 @@ CREATE OR REPLACE PACKAGE BODY import AS
     --
   BEGIN
     l_valid := true;
-    FOR r_csv IN csv_cur(p_fileid) LOOP
+    FOR r_csv IN csv_cur(p_fileid, p_shard, p_shards) LOOP
       l_current_csv := r_csv.csv_rec; -- Current csv_rec for error reporting
       l_filename := r_csv.filename;
 
@@ -831,7 +949,8 @@ CREATE OR REPLACE PACKAGE BODY import AS
   END demo_imp;
 
   FUNCTION ord_imp (
-    p_filename IN VARCHAR2
+    p_filename IN VARCHAR2,
+    p_fileid   IN importcsv.fileid%TYPE DEFAULT NULL
   ) RETURN BOOLEAN IS
     --
     CURSOR csv_cur (
@@ -887,23 +1006,28 @@ CREATE OR REPLACE PACKAGE BODY import AS
   BEGIN
     SAVEPOINT before_load_csv;
 
-    -- Load the order data into the staging table IMPORTCSV
-    l_fileid := util_file.load_csv(p_filename);
-    IF l_fileid = -1 THEN
-      RAISE e_file_not_found;
-    END IF;
-    SAVEPOINT csv_data_loaded;
-
-    -- Validate the data in the staging table, recording all errors found. 
-    -- If no errors, proceed, otherwise delete IMPORTCSV data
-    -- and exit.
-    IF NOT ord_valid(l_fileid) THEN
-      -- Invalid order data found
-      -- Delete data from staging table. CSV file will need to be fixed and re-processed.
-      -- NB: Cannot ROLLBACK to before_load_csv as you would lose the recorded invalid data messages
-      -- in the table importerror.
-      l_rec_count := util_file.delete_csv(l_fileid);
-      RAISE e_invalid_data;
+    IF p_fileid IS NOT NULL THEN
+      -- Already loaded and validated by ord_stage and ord_valid_shard, called from ord_commit
+      l_fileid := p_fileid;
+    ELSE
+      -- Load the order data into the staging table IMPORTCSV
+      l_fileid := util_file.load_csv(p_filename);
+      IF l_fileid = -1 THEN
+        RAISE e_file_not_found;
+      END IF;
+      SAVEPOINT csv_data_loaded;
+
+      -- Validate the data in the staging table, recording all errors found. 
+      -- If no errors, proceed, otherwise delete IMPORTCSV data
+      -- and exit.
+      IF NOT ord_valid(l_fileid) THEN
+        -- Invalid order data found
+        -- Delete data from staging table. CSV file will need to be fixed and re-processed.
+        -- NB: Cannot ROLLBACK to before_load_csv as you would lose the recorded invalid data messages
+        -- in the table importerror.
+        l_rec_count := util_file.delete_csv(l_fileid);
+        RAISE e_invalid_data;
+      END IF;
     END IF;
 
     SAVEPOINT data_validated;
@@ -1060,6 +1184,10 @@ CREATE OR REPLACE PACKAGE BODY import AS
       -- Maximum value of ORDID exceeded. Cannot allocate next ORDID. 
       -- The data will have been loaded into the staging table and passed validation without errors so rollback all the way to the beginning
       ROLLBACK TO before_load_csv;
+      -- Data staged by ord_stage was loaded in another session, delete it
+      IF p_fileid IS NOT NULL THEN
+        l_rec_count := util_file.delete_csv(p_fileid);
+      END IF;
       -- Log the error
       import_error(p_filename, rec_current_csv, 'IMPORT.ORD_IMP ORDID maximum value exceeded. Next ORDID is ' || to_char(l_next_ordid),
       NULL, sqlerrm);
@@ -1074,11 +1202,258 @@ CREATE OR REPLACE PACKAGE BODY import AS
       -- Report the error before executing the next command or you will lose the SQLERRM value
       import_error(p_filename, rec_current_csv, 'IMPORT.ORD_IMP Unexpected error. Order import failed.', NULL, sqlerrm);
       util_admin.log_message('Unexpected error importing file ' || p_filename, sqlerrm, 'IMPORT.ORD_IMP', 'B', gc_error);
+      -- Data staged by ord_stage was loaded in another session, delete it
+      IF p_fileid IS NOT NULL THEN
+        l_rec_count := util_file.delete_csv(p_fileid);
+      END IF;
       -- Move CSV file to error directory
       util_file.rename_file(gc_import_directory, p_filename, gc_import_error_dir, p_filename);
       RETURN false;
   END ord_imp;
 
+  FUNCTION ord_stage (
+    p_filename IN VARCHAR2
+  ) RETURN BOOLEAN IS
+    l_fileid        importcsv.fileid%TYPE;
+  BEGIN
+    SAVEPOINT before_load_csv;
+
+    -- Load the order data into the staging table IMPORTCSV
+    l_fileid := util_file.load_csv(p_filename);
+    IF l_fileid = -1 THEN
+      RAISE e_file_not_found;
+    END IF;
+
+    -- Record the file as staged. The row with no SHARD identifies the file for ord_commit.
+    INSERT INTO importshard (
+      fileid,
+      filename,
+      shard,
+      valid
+    ) VALUES (
+      l_fileid,
+      p_filename,
+      NULL,
+      NULL
+    );
+
+    RETURN true;
+  EXCEPTION
+    WHEN e_file_not_found THEN
+      -- CSV file not found so log the error
+      import_error(p_filename, NULL, 'IMPORT.ORD_STAGE File not found. Order import failed.', NULL, sqlerrm);
+      util_admin.log_message('File not found importing file ' || p_filename, sqlerrm, 'IMPORT.ORD_STAGE', 'B', gc_error);
+      RETURN false;
+    WHEN OTHERS THEN
+      -- Unexpected error so rollback to before the CSV data was loaded into the staging table
+      ROLLBACK TO before_load_csv;
+      import_error(p_filename, NULL, 'IMPORT.ORD_STAGE Unexpected error. Order import failed.', NULL, sqlerrm);
+      util_admin.log_message('Unexpected error importing file ' || p_filename, sqlerrm, 'IMPORT.ORD_STAGE', 'B', gc_error);
+      -- Move CSV file to error directory
+      util_file.rename_file(gc_import_directory, p_filename, gc_import_error_dir, p_filename);
+      RETURN false;
+  END ord_stage;
+
+  FUNCTION ord_valid_shard (
+    p_shard  IN NUMBER,
+    p_shards IN NUMBER
+  ) RETURN BOOLEAN IS
+    --
+    -- Staged files this shard has not validated yet
+    CURSOR file_cur (
+      p_shard NUMBER
+    ) IS
+    SELECT
+      s.fileid,
+      s.filename
+    FROM
+      importshard s
+    WHERE
+        s.shard IS NULL
+      AND NOT EXISTS (
+        SELECT
+          NULL
+        FROM
+          importshard v
+        WHERE
+            v.fileid = s.fileid
+          AND v.shard = p_shard
+      )
+    ORDER BY
+      s.fileid;
+    --
+    l_filename      importshard.filename%TYPE;
+    l_valid         importshard.valid%TYPE;
+    l_result        BOOLEAN := true;
+  BEGIN
+    IF p_shards < 1 OR p_shard < 0 OR p_shard >= p_shards THEN
+      raise_application_error(-20099, 'Shard ' || to_char(p_shard) || ' of ' || to_char(p_shards) || ' invalid');
+    END IF;
+
+    FOR r_file IN file_cur(p_shard) LOOP
+      l_filename := r_file.filename;
+      IF ord_valid(r_file.fileid, p_shard, p_shards) THEN
+        l_valid := 'Y';
+      ELSE
+        l_valid := 'N';
+        l_result := false;
+      END IF;
+
+      -- Each shard inserts its own row, so the shards do not wait on each other's locks
+      INSERT INTO importshard (
+        fileid,
+        filename,
+        shard,
+        valid
+      ) VALUES (
+        r_file.fileid,
+        NULL,
+        p_shard,
+        l_valid
+      );
+
+    END LOOP;
+
+    RETURN l_result;
+  EXCEPTION
+    WHEN OTHERS THEN
+      util_admin.log_message('Unexpected error validating shard ' || to_char(p_shard) || ' of file ' || l_filename, sqlerrm,
+                             'IMPORT.ORD_VALID_SHARD', 'B', gc_error);
+      RETURN false;
+  END ord_valid_shard;
+
+  FUNCTION ord_commit (
+    p_filename IN VARCHAR2,
+    p_shards   IN NUMBER
+  ) RETURN BOOLEAN IS
+    --
+    CURSOR csv_cur (
+      p_fileid importcsv.fileid%TYPE
+    ) IS
+    SELECT
+      recid,
+      csv_rec,
+      key_value
+    FROM
+      importcsv
+    WHERE
+        fileid = p_fileid
+      AND substr(csv_rec, 1, 9) <> '"Ord Ref"' -- Ignore header
+    ORDER BY
+      recid;
+    --
+    lc_delim        CONSTANT VARCHAR2(1) := ',';
+    --
+    l_fileid        importcsv.fileid%TYPE;
+    l_f_ordref      plsql_constants.csvfieldlength_t;
+    l_shards_run    NUMBER;
+    l_shards_valid  NUMBER;
+    l_existing      NUMBER;
+    l_rec_count     NUMBER;
+    l_valid         BOOLEAN := true;
+  BEGIN
+    -- Find the file staged by ord_stage
+    SELECT
+      MAX(fileid)
+    INTO l_fileid
+    FROM
+      importshard
+    WHERE
+        filename = p_filename
+      AND shard IS NULL;
+
+    IF l_fileid IS NULL THEN
+      RAISE e_file_not_staged;
+    END IF;
+
+    -- Every shard must have validated the file without errors
+    SELECT
+      COUNT(*),
+      COUNT(decode(valid, 'Y', 1))
+    INTO
+      l_shards_run,
+      l_shards_valid
+    FROM
+      importshard
+    WHERE
+        fileid = l_fileid
+      AND shard IS NOT NULL;
+
+    IF l_shards_run < p_shards THEN
+      l_valid := false;
+      import_error(p_filename, NULL, 'IMPORT.ORD_COMMIT File validated by '
+                                     || to_char(l_shards_run)
+                                     || ' of '
+                                     || to_char(p_shards)
+                                     || ' shards. Order import failed.');
+
+    ELSIF l_shards_valid < p_shards THEN
+      l_valid := false;
+    END IF;
+
+    -- The shards checked ORDREF against ORD before any file in the batch was imported.
+    -- An order imported by an earlier file since then is a duplicate, as ord_valid
+    -- would find running one file at a time.
+    IF l_valid THEN
+      FOR r_csv IN csv_cur(l_fileid) LOOP
+        l_f_ordref := util_string.get_field(r_csv.csv_rec, 1, lc_delim);
+        SELECT
+          COUNT(*)
+        INTO l_existing
+        FROM
+          ord o
+        WHERE
+          o.ordref = l_f_ordref;
+
+        IF l_existing > 0 THEN
+          l_valid := false;
+          import_error(p_filename, r_csv.csv_rec, 'OrdRef '
+                                                  || l_f_ordref
+                                                  || ' already exists on ORD, duplicate value', r_csv.key_value);
+
+        END IF;
+      END LOOP;
+    END IF;
+
+    DELETE FROM importshard
+    WHERE
+      fileid = l_fileid;
+
+    IF NOT l_valid THEN
+      -- Delete data from staging table. CSV file will need to be fixed and re-processed.
+      l_rec_count := util_file.delete_csv(l_fileid);
+      RAISE e_invalid_data;
+    END IF;
+
+    -- Insert the orders, delete the staged data and move the file to the processed directory
+    RETURN ord_imp(p_filename, l_fileid);
+  EXCEPTION
+    WHEN e_file_not_staged THEN
+      -- ord_stage has already recorded why the file was not loaded
+      util_admin.log_message('File not staged importing file ' || p_filename, sqlerrm, 'IMPORT.ORD_COMMIT', 'B', gc_error);
+      RETURN false;
+    WHEN e_invalid_data THEN
+      -- Log the error but do not rollback because we need to keep the validation error messages inserted into IMPORTERROR
+      util_admin.log_message('Invalid data importing file ' || p_filename, sqlerrm, 'IMPORT.ORD_COMMIT', 'B', gc_error);
+      -- Move CSV file to error directory
+      util_file.rename_file(gc_import_directory, p_filename, gc_import_error_dir, p_filename);
+      RETURN false;
+    WHEN OTHERS THEN
+      import_error(p_filename, NULL, 'IMPORT.ORD_COMMIT Unexpected error. Order import failed.', NULL, sqlerrm);
+      util_admin.log_message('Unexpected error importing file ' || p_filename, sqlerrm, 'IMPORT.ORD_COMMIT', 'B', gc_error);
+      -- Delete the staged data
+      IF l_fileid IS NOT NULL THEN
+        l_rec_count := util_file.delete_csv(l_fileid);
+        DELETE FROM importshard
+        WHERE
+          fileid = l_fileid;
+
+      END IF;
+      -- Move CSV file to error directory
+      util_file.rename_file(gc_import_directory, p_filename, gc_import_error_dir, p_filename);
+      RETURN false;
+  END ord_commit;
+
 END import;
 
 
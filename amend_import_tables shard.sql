@@ -0,0 +1,12 @@
+-- Add IMPORTSHARD table for the sharded order import
+-- Run as the application owner, then grant it to the connect user and create its synonym
+-- as in install_schema.sql
+
+CREATE TABLE importshard
+  ( FILEID      NUMBER(28,0),
+    FILENAME    VARCHAR2(255),
+    SHARD       NUMBER(5,0),
+    VALID       VARCHAR2(1)
+  );
+
+CREATE UNIQUE INDEX importshard_idx ON importshard (FILEID, SHARD);
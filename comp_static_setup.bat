@@ -1 +1,6 @@
-g++ setup.c -o setup.exe -static -static-libgcc -static-libstdc++ -lshlwapi -lole32 -luuid 
\ No newline at end of file
+g++ setup.c -o setup.exe -static -static-libgcc -static-libstdc++ -lshlwapi -lole32 -luuid 
+g++ seedload.c -o seedload.exe -static -static-libgcc -static-libstdc++ -lpsapi
+g++ -O2 salesagg.c -o salesagg.exe -static -static-libgcc -static-libstdc++
+g++ -O2 logq.c -o logq.exe -static -static-libgcc -static-libstdc++
+g++ -O2 ordbench.c order_schema.c order_import.c -o ordbench.exe -static -static-libgcc -static-libstdc++ -pthread -lpsapi
+g++ -O2 order_import_test.c order_schema.c order_import.c -o order_import_test.exe -static -static-libgcc -static-libstdc++ -pthread
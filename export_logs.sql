@@ -0,0 +1,43 @@
+/*
+** Copyright (c) 2022 Bond & Pollard Ltd. All rights reserved.  
+** NAME   : export_logs.sql
+**
+** DESCRIPTION
+**   Call PL/SQL package functions to export the APPLOG and IMPORTERROR
+**   tables to CSV files, to be loaded by the logq log query tool.
+**   Only rows with a RECID above &1 (APPLOG) and &2 (IMPORTERROR) are exported.
+**   Get the RECIDs from: logq watermark <store> applog|importerror [-host name]
+**   logq keeps its watermark below rows that may still commit out of RECID
+**   order, so some rows are exported again, logq skips the ones it has loaded.
+** 
+**------------------------------------------------------------------------------------------------------------------------------
+** MODIFICATION HISTORY
+**
+** Date         Name          Description
+**------------------------------------------------------------------------------------------------------------------------------
+** 18/10/2026   agent         Created
+** 18/10/2026   agent         Export only rows above the logq RECID watermarks, and run
+**                            both exports even if the first fails
+*/
+
+SET SERVEROUTPUT ON
+DECLARE 
+  v_applog_recid NUMBER := '&1';
+  v_error_recid NUMBER := '&2';
+  v_applog BOOLEAN;
+  v_errors BOOLEAN;
+BEGIN
+  -- Call each export separately, AND would skip import_errors if applog failed
+  v_applog := export.applog(v_applog_recid);
+  v_errors := export.import_errors(v_error_recid);
+  IF v_applog AND v_errors THEN
+    util_admin.log_message('Success!');
+  ELSE
+    raise_application_error (-20099,'Log export failed.');
+  END IF;
+EXCEPTION
+  WHEN OTHERS THEN
+    util_admin.log_message('Error exporting data',SQLERRM,'EXPORT_LOGS.SQL','B','E');
+END;
+/
+EXIT
@@ -0,0 +1,34 @@
+/*
+** Copyright (c) 2022 Bond & Pollard Ltd. All rights reserved.  
+** NAME   : export_order_batch.sql
+**
+** DESCRIPTION
+**   Call a PL/SQL package function to export the orders imported since
+**   ORDID &1 to a CSV file, to be applied to the sales aggregates by salesagg.
+**   Get the ORDID from: salesagg watermark <store>
+** 
+**------------------------------------------------------------------------------------------------------------------------------
+** MODIFICATION HISTORY
+**
+** Date         Name          Description
+**------------------------------------------------------------------------------------------------------------------------------
+** 18/10/2026   agent         Created
+*/
+
+SET SERVEROUTPUT ON
+DECLARE 
+  v_after_ordid NUMBER := '&1';
+  v_result BOOLEAN;
+BEGIN
+  v_result := export.order_batch(v_after_ordid);
+  IF v_result THEN
+    util_admin.log_message('Success!');
+  ELSE
+    raise_application_error (-20099,'Order batch export failed.');
+  END IF;
+EXCEPTION
+  WHEN OTHERS THEN
+    util_admin.log_message('Error exporting data',SQLERRM,'EXPORT_ORDER_BATCH.SQL','B','E');
+END;
+/
+EXIT
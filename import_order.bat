@@ -18,6 +18,21 @@ REM         Log all errors in the table IMPORTERROR, recording the filename, err
 REM         Move the CSV file to the error directory.
 REM     Delete the CSV file from the received directory.
 REM
+REM   If IMPORT_SHARDS is more than 1 (the default is 4) the files are imported in
+REM   three steps, so that the validation runs in several sessions at once:
+REM     Copy each CSV file to DATA_IN and load it into the staging table IMPORTCSV
+REM     (IMPORT_ORDER_STAGE.SQL), in the order found.
+REM     Validate the staged rows in IMPORT_SHARDS shards, split by a hash of the order
+REM     reference, with one SQL*Plus session per shard running at the same time
+REM     (IMPORT_ORDER_SHARD.SQL). Wait for every shard to finish.
+REM     Import each file in the order it was staged (IMPORT_ORDER_COMMIT.SQL). A file
+REM     is imported whole and moved to the processed directory, or moved to the error
+REM     directory with its errors in IMPORTERROR, as above.
+REM   Set IMPORT_SHARDS=1 to import each file with one SQL*Plus session as above.
+REM
+REM   Export the orders added since the last run to DATA_OUT and apply them to the
+REM   sales aggregates with salesagg.exe.
+REM
 REM ---------------------------------------------------------------------------------------
 REM MODIFICATION HISTORY
 REM
@@ -26,11 +41,17 @@ REM ----------------------------------------------------------------------------
 REM 21/07/2022   Ian Bond      Created script
 REM 06/03/2023   Ian Bond      Use CONNECT_USER to connect to the database. This user
 REM                            does not own any application schema objects.
+REM 18/10/2026   agent         Apply the imported orders to the sales aggregates.
+REM 18/10/2026   agent         Skip the sales aggregate update if salesagg fails, and log it.
+REM 18/10/2026   agent         Import the files in shards validated at the same time.
 
 
 REM Set the application environment variables
 CALL ..\config\SET_ENV
 
+IF "%IMPORT_SHARDS%"=="" SET IMPORT_SHARDS=4
+IF %IMPORT_SHARDS% GTR 1 GOTO SHARDED
+
 FOR /R %DATA_HOME%\RECEIVED %%F IN (ORDER*.CSV) DO ( 
   ECHO CSV FILE FOUND: %%F
   
@@ -42,4 +63,67 @@ FOR /R %DATA_HOME%\RECEIVED %%F IN (ORDER*.CSV) DO (
   
   REM Tidy up - delete the csv file from the received directory
   DEL "%%F"
-)
\ No newline at end of file
+)
+GOTO IMPORT_END
+
+:SHARDED
+SET IMPORT_LIST=%DATA_HOME%\import_order_files.txt
+SET SHARD_DIR=%DATA_HOME%\import_shards
+IF EXIST %IMPORT_LIST% DEL %IMPORT_LIST%
+
+REM Stage each file, and list them in the order they were staged
+FOR /R %DATA_HOME%\RECEIVED %%F IN (ORDER*.CSV) DO ( 
+  ECHO CSV FILE FOUND: %%F
+  COPY "%%F" "%DATA_HOME%\DATA_IN\%%~NXF"
+  SQLPLUS %CONNECT_USER%/%CONNECT_PWD%@%DBCONNECT% @%APP_HOME%\SQL\IMPORT_ORDER_STAGE.SQL "%%~NXF"
+  ECHO %%~NXF>>%IMPORT_LIST%
+  DEL "%%F"
+)
+IF NOT EXIST %IMPORT_LIST% GOTO IMPORT_END
+
+REM Start a SQL*Plus session for each shard. Each writes shard_<n>.done when it ends.
+IF NOT EXIST %SHARD_DIR% MKDIR %SHARD_DIR%
+DEL /Q %SHARD_DIR%\*.done 2>NUL
+SET /A LAST_SHARD=%IMPORT_SHARDS%-1
+FOR /L %%S IN (0,1,%LAST_SHARD%) DO (
+  START "Shard %%S" /B CMD /C "SQLPLUS -S %CONNECT_USER%/%CONNECT_PWD%@%DBCONNECT% @%APP_HOME%\SQL\IMPORT_ORDER_SHARD.SQL %%S %IMPORT_SHARDS% > %SHARD_DIR%\shard_%%S.log 2>&1 & ECHO done > %SHARD_DIR%\shard_%%S.done"
+)
+
+:SHARD_WAIT
+SET SHARDS_DONE=0
+FOR %%D IN (%SHARD_DIR%\*.done) DO SET /A SHARDS_DONE+=1
+IF %SHARDS_DONE% LSS %IMPORT_SHARDS% (
+  TIMEOUT /T 1 /NOBREAK > NUL
+  GOTO SHARD_WAIT
+)
+ECHO %IMPORT_SHARDS% shards validated, see %SHARD_DIR%\shard_*.log
+
+REM Import the files one at a time in the order they were staged
+FOR /F "usebackq delims=" %%N IN ("%IMPORT_LIST%") DO (
+  SQLPLUS %CONNECT_USER%/%CONNECT_PWD%@%DBCONNECT% @%APP_HOME%\SQL\IMPORT_ORDER_COMMIT.SQL "%%N" %IMPORT_SHARDS%
+)
+DEL %IMPORT_LIST%
+
+:IMPORT_END
+
+REM Export the orders imported since the sales aggregate watermark and apply them.
+REM salesagg prints an error instead of the watermark if the store cannot be used,
+REM so the export and apply are skipped unless it succeeds.
+SET AGG_OUT=%DATA_HOME%\salesagg_watermark.txt
+SET AGG_LOG=%DATA_HOME%\salesagg_error.log
+CALL %APP_HOME%\salesagg.exe watermark %DATA_HOME%\salesagg.dat > %AGG_OUT%
+IF %ERRORLEVEL% NEQ 0 GOTO AGG_FAILED
+SET /P WATERMARK=<%AGG_OUT%
+SQLPLUS %CONNECT_USER%/%CONNECT_PWD%@%DBCONNECT% @%APP_HOME%\SQL\EXPORT_ORDER_BATCH.SQL %WATERMARK%
+CALL %APP_HOME%\salesagg.exe apply %DATA_HOME%\salesagg.dat %DATA_HOME%\DATA_OUT\order_batch_%WATERMARK%.csv > %AGG_OUT%
+IF %ERRORLEVEL% NEQ 0 GOTO AGG_FAILED
+TYPE %AGG_OUT%
+GOTO AGG_END
+
+:AGG_FAILED
+ECHO Sales aggregates not updated:
+TYPE %AGG_OUT%
+ECHO %DATE% %TIME% Sales aggregates not updated >> %AGG_LOG%
+TYPE %AGG_OUT% >> %AGG_LOG%
+
+:AGG_END
@@ -0,0 +1,45 @@
+/*
+** Copyright (c) 2022 Bond & Pollard Ltd. All rights reserved.  
+** NAME   : import_order_commit.sql
+**
+** DESCRIPTION
+**
+**   Last step of the sharded order import run by import_order.bat, for
+**   each file in the order they were staged.
+**
+**   Call a PL/SQL package function to import the order file &1 once all
+**   &2 shards have validated it:
+**     If no errors
+**       Load the imported data into the order tables
+**       Move the CSV file to the processed directory
+**     Else if errors found
+**       Move the CSV file to the error directory
+**       Exit with an error status
+** 
+**------------------------------------------------------------------------------------------------------------------------------
+** MODIFICATION HISTORY
+**
+** Date         Name          Description
+**------------------------------------------------------------------------------------------------------------------------------
+** 18/10/2026   agent         Created
+*/
+
+SET SERVEROUTPUT ON
+DECLARE 
+  v_filename VARCHAR2(100) := '&1';
+  v_shards NUMBER := '&2';
+  v_result BOOLEAN;
+BEGIN
+  util_admin.log_message('Order Data Import from file: '||v_filename);
+  v_result := import.ord_commit(v_filename, v_shards);
+  IF v_result THEN
+    util_admin.log_message('Success!');
+  ELSE
+    raise_application_error (-20099,'Order import failed. View errors in IMPORTERROR for file '||v_filename);
+  END IF;
+EXCEPTION
+  WHEN OTHERS THEN
+    util_admin.log_message('Error importing file ' || v_filename,SQLERRM,'IMPORT_ORDER_COMMIT.SQL','B','E');
+END;
+/
+EXIT
@@ -0,0 +1,39 @@
+/*
+** Copyright (c) 2022 Bond & Pollard Ltd. All rights reserved.  
+** NAME   : import_order_shard.sql
+**
+** DESCRIPTION
+**
+**   Second step of the sharded order import run by import_order.bat, which
+**   runs this script for every shard at the same time.
+**
+**   Call a PL/SQL package function to validate shard &1 of &2 of the order
+**   files staged by import_order_stage.sql, recording all errors in table
+**   IMPORTERROR and the result for each file in table IMPORTSHARD.
+** 
+**------------------------------------------------------------------------------------------------------------------------------
+** MODIFICATION HISTORY
+**
+** Date         Name          Description
+**------------------------------------------------------------------------------------------------------------------------------
+** 18/10/2026   agent         Created
+*/
+
+SET SERVEROUTPUT ON
+DECLARE 
+  v_shard NUMBER := '&1';
+  v_shards NUMBER := '&2';
+  v_result BOOLEAN;
+BEGIN
+  v_result := import.ord_valid_shard(v_shard, v_shards);
+  IF v_result THEN
+    util_admin.log_message('Success!');
+  ELSE
+    raise_application_error (-20099,'Order validation found errors in shard '||v_shard||'. View errors in IMPORTERROR');
+  END IF;
+EXCEPTION
+  WHEN OTHERS THEN
+    util_admin.log_message('Error validating shard ' || v_shard,SQLERRM,'IMPORT_ORDER_SHARD.SQL','B','E');
+END;
+/
+EXIT
@@ -0,0 +1,38 @@
+/*
+** Copyright (c) 2022 Bond & Pollard Ltd. All rights reserved.  
+** NAME   : import_order_stage.sql
+**
+** DESCRIPTION
+**
+**   First step of the sharded order import run by import_order.bat.
+**
+**   Call a PL/SQL package function to load order data in the CSV file &1
+**   into the staging table IMPORTCSV, ready to be validated by
+**   import_order_shard.sql and imported by import_order_commit.sql.
+** 
+**------------------------------------------------------------------------------------------------------------------------------
+** MODIFICATION HISTORY
+**
+** Date         Name          Description
+**------------------------------------------------------------------------------------------------------------------------------
+** 18/10/2026   agent         Created
+*/
+
+SET SERVEROUTPUT ON
+DECLARE 
+  v_filename VARCHAR2(100) := '&1';
+  v_result BOOLEAN;
+BEGIN
+  util_admin.log_message('Order Data Import staging file: '||v_filename);
+  v_result := import.ord_stage(v_filename);
+  IF v_result THEN
+    util_admin.log_message('Success!');
+  ELSE
+    raise_application_error (-20099,'Order import failed. View errors in IMPORTERROR for file '||v_filename);
+  END IF;
+EXCEPTION
+  WHEN OTHERS THEN
+    util_admin.log_message('Error staging file ' || v_filename,SQLERRM,'IMPORT_ORDER_STAGE.SQL','B','E');
+END;
+/
+EXIT
@@ -62,6 +62,7 @@
 **                            Foreign key <table_from>_<table_to>_FK. Only for objects added to Oracle demo.
 ** 06/03/2023   Ian Bond      Add a connection user that will be used by all applications that connect to the database.
 ** 12/03/2025   Ian Bond      Fix problem with public synonyms being replaced each time a new version of demo app installed.        
+** 18/10/2026   agent         Add IMPORTSHARD table for the sharded order import.
 */
 
 /*
@@ -554,6 +555,24 @@
   CREATE UNIQUE INDEX IMPORTERROR_IDX ON IMPORTERROR (RECID) ;
   ALTER TABLE IMPORTERROR ADD CONSTRAINT IMPORTERROR_PK PRIMARY KEY (RECID) ENABLE;
 
+
+/*
+ ***********************
+ * IMPORTSHARD table   *
+ ***********************
+ * Files staged on IMPORTCSV by IMPORT.ORD_STAGE have a row with no SHARD. Each
+ * IMPORT.ORD_VALID_SHARD session adds a row for its SHARD, VALID Y or N.
+*/ 
+  CREATE TABLE IMPORTSHARD
+   (	
+    FILEID            NUMBER(28,0), 
+    FILENAME          VARCHAR2(255),
+    SHARD             NUMBER(5,0),
+    VALID             VARCHAR2(1)
+   ) ;
+
+  CREATE UNIQUE INDEX IMPORTSHARD_IDX ON IMPORTSHARD (FILEID, SHARD) ;
+
   
 /*
  *****************
@@ -643,6 +662,7 @@
   GRANT DELETE, INSERT, SELECT, UPDATE ON emp              TO &v_connect_user;
   GRANT DELETE, INSERT, SELECT, UPDATE ON importcsv        TO &v_connect_user;
   GRANT DELETE, INSERT, SELECT, UPDATE ON importerror      TO &v_connect_user;
+  GRANT DELETE, INSERT, SELECT, UPDATE ON importshard      TO &v_connect_user;
   GRANT DELETE, INSERT, SELECT, UPDATE ON item             TO &v_connect_user;
   GRANT DELETE, INSERT, SELECT, UPDATE ON ord              TO &v_connect_user;
   GRANT DELETE, INSERT, SELECT, UPDATE ON price            TO &v_connect_user;
@@ -682,6 +702,7 @@
   CREATE OR REPLACE SYNONYM emp             FOR &v_app_owner\.emp;
   CREATE OR REPLACE SYNONYM importcsv       FOR &v_app_owner\.importcsv;
   CREATE OR REPLACE SYNONYM importerror     FOR &v_app_owner\.importerror;
+  CREATE OR REPLACE SYNONYM importshard     FOR &v_app_owner\.importshard;
   CREATE OR REPLACE SYNONYM item            FOR &v_app_owner\.item;
   CREATE OR REPLACE SYNONYM ord             FOR &v_app_owner\.ord;
   CREATE OR REPLACE SYNONYM price           FOR &v_app_owner\.price;
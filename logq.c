@@ -0,0 +1,1246 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <ctype.h>
+#include <time.h>
+#include <sys/stat.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <algorithm>
+#include <iterator>
+#ifdef _WIN32
+#include <windows.h>
+#include <direct.h>       // For _mkdir()
+#include <io.h>           // For _chsize_s()
+#else
+#include <unistd.h>
+#endif
+
+/*
+  Program Name   : logq.c
+  Description    : Log ingestion and query tool
+  Copyright      : Bond & Pollard Ltd 2025
+  Auther         : agent
+  Date           : 18 October 2026
+
+
+  Loads install.log files written by setup, and the APPLOG and IMPORTERROR
+  exports written by EXPORT.APPLOG and EXPORT.IMPORT_ERRORS (export_logs.sql),
+  into a column store directory, so that they can be searched and counted
+  without scanning the original files.
+
+  The store holds one file per column. Program, severity, user, filename and
+  host are dictionary encoded. A time ordered index gives date range scans and
+  an inverted index on message words gives text search.
+
+  Ingest is incremental: only install.log lines added since the last ingest,
+  and APPLOG and IMPORTERROR rows not loaded before for the host, are added. Use -host to name the database or machine the files
+  came from. New rows are appended to the column files, and each word in them
+  gets a new segment of postings appended to tokens.post. state.txt is written
+  last and records the row count and index lengths, so an ingest that does not
+  finish is cut off the files the next time the store is opened for ingest.
+
+    logq ingest <store> [-host name] <file>...
+    logq search <store> [filters] [-limit n]
+    logq count  <store> [filters] -by field[,field] [-top n]
+    logq stats  <store>
+    logq watermark <store> applog|importerror [-host name]
+
+  Filters: -program name -severity E|W|I -user name -file name -host name
+           -source install|applog|importerror
+           -from "DD/MM/YYYY[ HH:MI:SS]" -to "DD/MM/YYYY[ HH:MI:SS]"
+           -text "words"        Rows containing all the words
+  Fields:  program severity user file host source hour day
+
+  watermark prints the APPLOG or IMPORTERROR RECID for the host that every row
+  up to has been loaded or was never committed, 0 if none, to pass to
+  export_logs.sql. RECID is taken from an identity when the row is inserted, not
+  when it commits, so a session can commit RECID 105 before another commits 104.
+  The store keeps the RECIDs above the watermark that have been loaded, and the
+  ones still missing, in state.txt. Rows above the watermark are exported again
+  each time and the ones already loaded are skipped. The watermark only moves past
+  a missing RECID once it has been missing for LOG_SETTLE_SECS, when it is taken
+  to be an identity gap (a rolled back insert or lost cached values). The first
+  export loaded for a host sets the watermark to its highest RECID.
+
+  Examples:
+    Errors per program per hour:  logq count store -severity E -by program,hour
+    Top failing files:            logq count store -source importerror -by file -top 10
+
+  Build: g++ -O2 -o logq.exe logq.c
+
+ */
+
+
+#ifdef _WIN32
+#define DIR_DELIMITER "\\"
+#else
+#define DIR_DELIMITER "/"
+#endif
+
+#define DICT_COUNT       5
+#define POST_MERGE_SEGMENTS  32          // Segments a word's postings may have before they are written as one
+#define POST_REPLACE     0x80000000U     // tokens.dir count flag, the segment replaces the word's earlier ones
+#define MAX_LINE         40000
+#define SOURCE_INSTALL   0
+#define SOURCE_APPLOG    1
+#define SOURCE_ERROR     2
+#define LOG_SETTLE_SECS  3600            // Time a missing RECID is waited for before it is treated as a gap
+
+enum dict_column_t { COL_PROGRAM = 0, COL_SEVERITY = 1, COL_USER = 2, COL_FILE = 3, COL_HOST = 4 };
+
+static const char *dict_name[DICT_COUNT] = { "program", "severity", "user", "file", "host" };
+static const char *source_name[3] = { "install", "applog", "importerror" };
+
+typedef struct {
+    std::vector<std::string>                  values;
+    std::unordered_map<std::string, uint32_t> ids;
+    size_t                                    saved;     // Values already written to the store
+} dictionary_t;
+
+typedef struct {
+    uint64_t    offset;      // First entry in tokens.post
+    uint32_t    count;
+} post_segment_t;
+
+typedef struct {
+    std::string                 token;
+    std::vector<post_segment_t> segments;    // Row numbers ascend through the segments
+    uint32_t                    count;
+} token_entry_t;
+
+typedef struct {
+    std::string                 dir;
+    uint64_t                    rows;
+    uint64_t                    saved_rows;              // Rows already written to the column files
+    dictionary_t                dict[DICT_COUNT];
+    std::vector<int64_t>        time;                    // Seconds, from DD/MM/YYYY HH:MI:SS
+    std::vector<uint8_t>        source;
+    std::vector<uint32_t>       column[DICT_COUNT];
+    std::vector<uint64_t>       text_offset;
+    std::vector<uint32_t>       text_length;
+    std::vector<std::string>    new_text;                // Message text of rows not yet saved
+    std::vector<uint32_t>       time_order;              // Row numbers in time order
+    std::vector<token_entry_t>  token_dir;               // Sorted by token
+    std::map<std::string, int64_t> watermark;            // RECID or byte offset loaded up to per source
+    std::map<std::string, std::map<int64_t, int64_t> > pending;  // RECIDs above the watermark per source, to
+                                                         // 0 once loaded, else when first found missing
+    int64_t                     post_length;             // Bytes of tokens.post and tokens.dir saved,
+    int64_t                     dir_length;              // -1 if state.txt does not say
+} log_store_t;
+
+// A row being ingested
+typedef struct {
+    int64_t     time;
+    uint8_t     source;
+    std::string value[DICT_COUNT];
+    std::string text;
+} log_row_t;
+
+typedef struct {
+    const char *value[DICT_COUNT];
+    int         source;
+    int64_t     from;
+    int64_t     to;
+    const char *text;
+    int         limit;
+    int         top;
+    const char *by;
+} query_t;
+
+
+static std::string store_file(const log_store_t *store, const char *name) {
+    return store->dir + DIR_DELIMITER + name;
+}
+
+// fseek and ftell with 64 bit offsets, long is 32 bits on Windows
+static int seek_file(FILE *file, int64_t offset, int origin) {
+#ifdef _WIN32
+    return _fseeki64(file, offset, origin);
+#else
+    return fseeko(file, (off_t)offset, origin);
+#endif
+}
+
+static int64_t tell_file(FILE *file) {
+#ifdef _WIN32
+    return _ftelli64(file);
+#else
+    return (int64_t)ftello(file);
+#endif
+}
+
+// Length of a file in bytes, -1 if it cannot be opened
+static int64_t file_length(const std::string &path) {
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return -1;
+    }
+    int64_t length = seek_file(file, 0, SEEK_END) == 0 ? tell_file(file) : -1;
+    fclose(file);
+    return length;
+}
+
+// Cut a file back to length bytes, dropping anything an unfinished ingest wrote after it
+static bool truncate_file(const std::string &path, uint64_t length) {
+    int64_t size = file_length(path);
+    if (size < 0 || (uint64_t)size <= length) {
+        return true;
+    }
+#ifdef _WIN32
+    FILE *file = fopen(path.c_str(), "r+b");
+    if (!file) {
+        return false;
+    }
+    bool ok = _chsize_s(_fileno(file), (__int64)length) == 0;
+    fclose(file);
+    return ok;
+#else
+    return truncate(path.c_str(), (off_t)length) == 0;
+#endif
+}
+
+// Replace path with temp_path in one step, so there is always a complete file
+static bool replace_file(const std::string &temp_path, const std::string &path) {
+#ifdef _WIN32
+    return MoveFileEx(temp_path.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return rename(temp_path.c_str(), path.c_str()) == 0;
+#endif
+}
+
+static bool make_directory(const std::string &path) {
+    struct stat info;
+    if (stat(path.c_str(), &info) == 0) {
+        return (info.st_mode & S_IFDIR) != 0;
+    }
+#ifdef _WIN32
+    return _mkdir(path.c_str()) == 0;
+#else
+    return mkdir(path.c_str(), 0755) == 0;
+#endif
+}
+
+static int64_t days_from_civil(int year, int month, int day) {
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    int64_t yoe = year - era * 400;
+    int64_t doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+// Parse DD/MM/YYYY with an optional HH:MI:SS. Returns the characters used, or 0 if not a date.
+static int parse_timestamp(const char *text, int64_t *seconds) {
+    int day, month, year, hour = 0, minute = 0, second = 0, used = 0;
+    if (sscanf(text, "%2d/%2d/%4d%n", &day, &month, &year, &used) != 3
+        || day < 1 || day > 31 || month < 1 || month > 12) {
+        return 0;
+    }
+    int time_used = 0;
+    if (sscanf(text + used, " %2d:%2d:%2d%n", &hour, &minute, &second, &time_used) == 3) {
+        used += time_used;
+    }
+    *seconds = days_from_civil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+    return used;
+}
+
+static void format_timestamp(int64_t seconds, char *buffer, size_t size, bool hour_only) {
+    int64_t days = seconds / 86400, rest = seconds % 86400;
+    if (rest < 0) {
+        rest += 86400;
+        days--;
+    }
+    // Civil date from days since 1970, the inverse of days_from_civil
+    int64_t z = days + 719468;
+    int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    int64_t doe = z - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+    int day = (int)(doy - (153 * mp + 2) / 5 + 1);
+    int month = (int)(mp < 10 ? mp + 3 : mp - 9);
+    int year = (int)(yoe + era * 400 + (month <= 2));
+    if (hour_only) {
+        snprintf(buffer, size, "%02d/%02d/%04d %02d:00", day, month, year, (int)(rest / 3600));
+    } else {
+        snprintf(buffer, size, "%02d/%02d/%04d %02d:%02d:%02d", day, month, year, (int)(rest / 3600),
+                 (int)(rest / 60 % 60), (int)(rest % 60));
+    }
+}
+
+// Split message text into lower case words for the inverted index
+static void tokenize(const std::string &text, std::vector<std::string> &tokens) {
+    std::string token;
+    tokens.clear();
+    for (size_t i = 0; i <= text.size(); i++) {
+        char c = i < text.size() ? text[i] : ' ';
+        if (isalnum((unsigned char)c) || c == '_') {
+            token += (char)tolower((unsigned char)c);
+        } else if (!token.empty()) {
+            tokens.push_back(token);
+            token.clear();
+        }
+    }
+    std::sort(tokens.begin(), tokens.end());
+    tokens.erase(std::unique(tokens.begin(), tokens.end()), tokens.end());
+}
+
+// Split a CSV record written by the EXPORT package: quoted fields, with quotes doubled
+static void split_csv(const char *rec, std::vector<std::string> &fields) {
+    std::string field;
+    bool quoted = false;
+    fields.clear();
+    for (const char *p = rec; ; p++) {
+        if (quoted) {
+            if (*p == '"' && p[1] == '"') {
+                field += '"';
+                p++;
+            } else if (*p == '"') {
+                quoted = false;
+            } else if (*p == '\0') {
+                break;
+            } else {
+                field += *p;
+            }
+        } else if (*p == '"') {
+            quoted = true;
+        } else if (*p == ',' || *p == '\0' || *p == '\n' || *p == '\r') {
+            fields.push_back(field);
+            field.clear();
+            if (*p != ',') break;
+        } else {
+            field += *p;
+        }
+    }
+}
+
+template <typename T>
+static bool read_column(const std::string &path, std::vector<T> &values, uint64_t rows) {
+    values.resize(rows);
+    if (rows == 0) {
+        return true;
+    }
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    bool ok = fread(values.data(), sizeof(T), rows, file) == rows;
+    fclose(file);
+    return ok;
+}
+
+template <typename T>
+static bool write_column(const std::string &path, const T *values, size_t count, bool append) {
+    FILE *file = fopen(path.c_str(), append ? "ab" : "wb");
+    if (!file) {
+        printf("Error: Cannot open %s for writing!\n", path.c_str());
+        return false;
+    }
+    bool ok = count == 0 || fwrite(values, sizeof(T), count, file) == count;
+    ok = fclose(file) == 0 && ok;
+    return ok;
+}
+
+static uint32_t dictionary_id(dictionary_t *dict, const std::string &value) {
+    std::unordered_map<std::string, uint32_t>::iterator it = dict->ids.find(value);
+    if (it != dict->ids.end()) {
+        return it->second;
+    }
+    uint32_t id = (uint32_t)dict->values.size();
+    dict->values.push_back(value);
+    dict->ids[value] = id;
+    return id;
+}
+
+// Look up a filter value, ignoring case. Returns -1 if the value is not in the dictionary.
+static int64_t find_dictionary_id(const dictionary_t *dict, const char *value) {
+    for (size_t i = 0; i < dict->values.size(); i++) {
+        const std::string &entry = dict->values[i];
+        if (entry.size() == strlen(value)) {
+            size_t j = 0;
+            while (j < entry.size() && toupper((unsigned char)entry[j]) == toupper((unsigned char)value[j])) j++;
+            if (j == entry.size()) return (int64_t)i;
+        }
+    }
+    return -1;
+}
+
+static void load_state(log_store_t *store) {
+    FILE *file = fopen(store_file(store, "state.txt").c_str(), "r");
+    char line[2048], name[1900];
+    long long value;
+    store->rows = 0;
+    store->post_length = -1;
+    store->dir_length = -1;
+    if (!file) {
+        return;
+    }
+    while (fgets(line, sizeof(line), file)) {
+        if (sscanf(line, "%lld %1899[^\n]", &value, name) == 2) {
+            if (strcmp(name, "rows") == 0) {
+                store->rows = (uint64_t)value;
+            } else if (strcmp(name, "tokens.post") == 0) {
+                store->post_length = value;
+            } else if (strcmp(name, "tokens.dir") == 0) {
+                store->dir_length = value;
+            } else if (strncmp(name, "pending ", 8) == 0) {
+                long long recid;
+                int used = 0;
+                if (sscanf(name + 8, "%lld %n", &recid, &used) == 1 && used > 0) {
+                    store->pending[name + 8 + used][recid] = value;
+                }
+            } else {
+                store->watermark[name] = value;
+            }
+        }
+    }
+    fclose(file);
+}
+
+static bool save_state(log_store_t *store) {
+    std::string path = store_file(store, "state.txt");
+    std::string temp_path = path + ".tmp";
+    FILE *file = fopen(temp_path.c_str(), "w");
+    if (!file) {
+        printf("Error: Cannot open %s for writing!\n", temp_path.c_str());
+        return false;
+    }
+    fprintf(file, "%llu rows\n", (unsigned long long)store->rows);
+    fprintf(file, "%lld tokens.post\n", (long long)store->post_length);
+    fprintf(file, "%lld tokens.dir\n", (long long)store->dir_length);
+    for (std::map<std::string, int64_t>::iterator it = store->watermark.begin(); it != store->watermark.end(); ++it) {
+        fprintf(file, "%lld %s\n", (long long)it->second, it->first.c_str());
+    }
+    for (std::map<std::string, std::map<int64_t, int64_t> >::iterator it = store->pending.begin();
+         it != store->pending.end(); ++it) {
+        for (std::map<int64_t, int64_t>::iterator recid = it->second.begin(); recid != it->second.end(); ++recid) {
+            fprintf(file, "%lld pending %lld %s\n", (long long)recid->second, (long long)recid->first, it->first.c_str());
+        }
+    }
+    if (fclose(file) != 0) {
+        return false;
+    }
+    return replace_file(temp_path, path);
+}
+
+// Load the dictionaries. A last line without a newline was cut short by an ingest that did not
+// finish, it is dropped, and cut off the file when truncate is set.
+static bool load_dictionaries(log_store_t *store, bool truncate) {
+    char line[MAX_LINE];
+    for (int d = 0; d < DICT_COUNT; d++) {
+        dictionary_t *dict = &store->dict[d];
+        std::string path = store_file(store, dict_name[d]) + ".dict";
+        FILE *file = fopen(path.c_str(), "rb");
+        int64_t complete = 0;
+        if (file) {
+            while (fgets(line, sizeof(line), file)) {
+                size_t len = strlen(line);
+                if (len == 0 || line[len - 1] != '\n') {
+                    break;
+                }
+                complete += (int64_t)len;
+                line[strcspn(line, "\r\n")] = '\0';
+                dictionary_id(dict, line);
+            }
+            fclose(file);
+            if (truncate && !truncate_file(path, (uint64_t)complete)) {
+                return false;
+            }
+        }
+        dict->saved = dict->values.size();
+    }
+    return true;
+}
+
+// Load the word directory, the first dir_length bytes of tokens.dir. Each record adds a segment
+// to a word's postings, or replaces them if it has POST_REPLACE set.
+static bool load_token_dir(log_store_t *store) {
+    FILE *file = fopen(store_file(store, "tokens.dir").c_str(), "rb");
+    if (!file) {
+        return true;
+    }
+    std::map<std::string, token_entry_t> tokens;
+    uint16_t length;
+    char token[65536];
+    int64_t used = 0;
+    while ((store->dir_length < 0 || used < store->dir_length) && fread(&length, sizeof(length), 1, file) == 1) {
+        post_segment_t segment;
+        uint32_t count;
+        if (fread(token, 1, length, file) != length || fread(&segment.offset, sizeof(segment.offset), 1, file) != 1
+            || fread(&count, sizeof(count), 1, file) != 1) {
+            fclose(file);
+            return false;
+        }
+        used += (int64_t)(sizeof(length) + length + sizeof(segment.offset) + sizeof(count));
+        token_entry_t &entry = tokens[std::string(token, length)];
+        if (count & POST_REPLACE) {
+            entry.segments.clear();
+            entry.count = 0;
+        }
+        segment.count = count & ~POST_REPLACE;
+        entry.segments.push_back(segment);
+        entry.count += segment.count;
+    }
+    fclose(file);
+    for (std::map<std::string, token_entry_t>::iterator it = tokens.begin(); it != tokens.end(); ++it) {
+        it->second.token = it->first;
+        store->token_dir.push_back(it->second);
+    }
+    return true;
+}
+
+// Bytes of text.dat used by the saved rows
+static uint64_t text_size(const log_store_t *store) {
+    return store->rows == 0 ? 0 : store->text_offset[store->rows - 1] + store->text_length[store->rows - 1];
+}
+
+// Cut the column, text and postings files back to the rows recorded in state.txt, so rows
+// appended by an ingest that did not finish are not read as the next ingest's rows
+static bool truncate_store(log_store_t *store) {
+    uint64_t rows = store->rows;
+    bool ok = truncate_file(store_file(store, "time.col"), rows * sizeof(int64_t))
+           && truncate_file(store_file(store, "source.col"), rows * sizeof(uint8_t))
+           && truncate_file(store_file(store, "text.off"), rows * sizeof(uint64_t))
+           && truncate_file(store_file(store, "text.len"), rows * sizeof(uint32_t))
+           && truncate_file(store_file(store, "text.dat"), text_size(store));
+    for (int d = 0; d < DICT_COUNT && ok; d++) {
+        ok = truncate_file(store_file(store, dict_name[d]) + ".col", rows * sizeof(uint32_t));
+    }
+    if (ok && store->post_length >= 0) {
+        ok = truncate_file(store_file(store, "tokens.post"), (uint64_t)store->post_length);
+    }
+    if (ok && store->dir_length >= 0) {
+        ok = truncate_file(store_file(store, "tokens.dir"), (uint64_t)store->dir_length);
+    }
+    return ok;
+}
+
+// The time index is rewritten whole, so it can be short or hold rows the state does not have if it
+// was not saved with the state. Sort the rows again from time.col if so.
+static void check_time_order(log_store_t *store, bool loaded) {
+    bool valid = loaded && file_length(store_file(store, "time.idx")) == (int64_t)(store->rows * sizeof(uint32_t));
+    for (size_t i = 0; i < store->time_order.size() && valid; i++) {
+        valid = store->time_order[i] < store->rows;
+    }
+    if (valid) {
+        return;
+    }
+    std::vector<int64_t> &time = store->time;
+    store->time_order.resize(store->rows);
+    for (size_t i = 0; i < store->time_order.size(); i++) {
+        store->time_order[i] = (uint32_t)i;
+    }
+    std::stable_sort(store->time_order.begin(), store->time_order.end(),
+                     [&time](uint32_t a, uint32_t b) { return time[a] < time[b]; });
+}
+
+// Open the store, loading the columns a query or ingest needs. Opening for ingest (create)
+// also cuts off anything an earlier ingest wrote without updating state.txt.
+static bool open_store(log_store_t *store, const char *dir, bool create) {
+    store->dir = dir;
+    if (create && !make_directory(store->dir)) {
+        printf("Error: Could not create log store %s\n", dir);
+        return false;
+    }
+    struct stat info;
+    if (stat(store_file(store, "state.txt").c_str(), &info) != 0 && !create) {
+        printf("Error: Log store %s not found.\n", dir);
+        return false;
+    }
+    load_state(store);
+    store->saved_rows = store->rows;
+    bool ok = load_dictionaries(store, create)
+        && read_column(store_file(store, "time.col"), store->time, store->rows)
+        && read_column(store_file(store, "source.col"), store->source, store->rows)
+        && read_column(store_file(store, "text.off"), store->text_offset, store->rows)
+        && read_column(store_file(store, "text.len"), store->text_length, store->rows)
+        && load_token_dir(store);
+    for (int d = 0; d < DICT_COUNT && ok; d++) {
+        ok = read_column(store_file(store, dict_name[d]) + ".col", store->column[d], store->rows);
+    }
+    if (ok && create) {
+        ok = truncate_store(store);
+    }
+    if (ok) {
+        check_time_order(store, read_column(store_file(store, "time.idx"), store->time_order, store->rows));
+    }
+    if (!ok) {
+        printf("Error: Log store %s is damaged, delete it and ingest the logs again.\n", dir);
+    }
+    return ok;
+}
+
+static void add_row(log_store_t *store, log_row_t *row, uint64_t *text_end) {
+    store->time.push_back(row->time);
+    store->source.push_back(row->source);
+    for (int d = 0; d < DICT_COUNT; d++) {
+        store->column[d].push_back(dictionary_id(&store->dict[d], row->value[d]));
+    }
+    store->text_offset.push_back(*text_end);
+    store->text_length.push_back((uint32_t)row->text.size());
+    *text_end += row->text.size();
+    store->new_text.push_back(row->text);
+    store->rows++;
+}
+
+// Severity of an install.log message
+static const char *install_severity(const char *message) {
+    if (strncmp(message, "Error", 5) == 0 || strncmp(message, "ERROR", 5) == 0) return "E";
+    if (strncmp(message, "Warning", 7) == 0 || strncmp(message, "WARNING", 7) == 0) return "W";
+    return "I";
+}
+
+// File named in an APPLOG message such as "Invalid data importing file ORDER1.csv"
+static std::string message_filename(const std::string &message) {
+    size_t end = message.size();
+    while (end > 0) {
+        size_t start = message.rfind(' ', end - 1);
+        start = start == std::string::npos ? 0 : start + 1;
+        std::string word = message.substr(start, end - start);
+        if (word.size() > 4) {
+            std::string ext = word.substr(word.size() - 4);
+            for (size_t i = 0; i < ext.size(); i++) ext[i] = (char)tolower((unsigned char)ext[i]);
+            if (ext == ".csv") return word;
+        }
+        if (start == 0) break;
+        end = start - 1;
+    }
+    return std::string();
+}
+
+// Local date and time of a file time, in the same seconds as parse_timestamp
+static int64_t civil_seconds(time_t value) {
+    struct tm *local = localtime(&value);
+    if (!local) {
+        return 0;
+    }
+    return days_from_civil(local->tm_year + 1900, local->tm_mon + 1, local->tm_mday) * 86400
+         + local->tm_hour * 3600 + local->tm_min * 60 + local->tm_sec;
+}
+
+// Load the lines added to an install.log since the last ingest
+static int64_t ingest_install_log(log_store_t *store, const char *path, const std::string &host, uint64_t *text_end) {
+    std::string key = "install " + host + " " + path;
+    int64_t offset = store->watermark.count(key) ? store->watermark[key] : 0;
+    struct stat info;
+    if (stat(path, &info) != 0) {
+        printf("Error: Could not open %s\n", path);
+        return -1;
+    }
+    if ((int64_t)info.st_size < offset) {
+        offset = 0;    // The log has been replaced
+    }
+
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        printf("Error: Could not open %s\n", path);
+        return -1;
+    }
+    seek_file(file, offset, SEEK_SET);
+    char line[MAX_LINE];
+    int64_t added = 0;
+    int64_t last_time = civil_seconds(info.st_mtime);   // Used until a timestamped line is found
+
+    while (fgets(line, sizeof(line), file)) {
+        size_t len = strlen(line);
+        if (len == 0 || line[len - 1] != '\n') {
+            break;    // Incomplete last line, pick it up next time
+        }
+        offset += (int64_t)len;
+        line[strcspn(line, "\r\n")] = '\0';
+
+        int64_t seconds;
+        int used = parse_timestamp(line, &seconds);
+        const char *message = line + used;
+        while (*message == ' ') message++;
+        if (used > 0) {
+            last_time = seconds;
+        }
+        bool has_text = false;
+        for (const char *p = message; *p && !has_text; p++) has_text = isalnum((unsigned char)*p) != 0;
+        if (!has_text) {
+            continue;
+        }
+
+        log_row_t row;
+        row.time   = last_time;
+        row.source = SOURCE_INSTALL;
+        row.value[COL_PROGRAM]  = "SETUP";
+        row.value[COL_SEVERITY] = install_severity(message);
+        row.value[COL_HOST]     = host;
+        row.text = message;
+        add_row(store, &row, text_end);
+        added++;
+    }
+    fclose(file);
+    store->watermark[key] = offset;
+    return added;
+}
+
+// Move the watermark up over RECIDs that have been loaded and RECIDs that have been missing for
+// LOG_SETTLE_SECS. Missing RECIDs up to the highest one seen are added to the pending list.
+static int64_t next_watermark(std::map<int64_t, int64_t> &pending, int64_t watermark, int64_t high, int64_t now) {
+    for (int64_t recid = watermark + 1; recid <= high; recid++) {
+        if (pending.find(recid) == pending.end()) {
+            pending[recid] = now;
+        }
+    }
+    while (!pending.empty() && pending.begin()->first == watermark + 1
+           && (pending.begin()->second == 0 || now - pending.begin()->second >= LOG_SETTLE_SECS)) {
+        watermark++;
+        pending.erase(pending.begin());
+    }
+    return watermark;
+}
+
+// Load the APPLOG or IMPORTERROR export rows not loaded before for the host
+static int64_t ingest_export(log_store_t *store, FILE *file, int source, const std::string &host, uint64_t *text_end) {
+    std::string key = std::string(source_name[source]) + " " + host;
+    bool first = store->watermark.count(key) == 0;
+    int64_t watermark = first ? 0 : store->watermark[key];
+    std::map<int64_t, int64_t> &pending = store->pending[key];
+    int64_t high = pending.empty() ? watermark : pending.rbegin()->first, added = 0;
+    char line[MAX_LINE];
+    std::vector<std::string> f;
+
+    while (fgets(line, sizeof(line), file)) {
+        split_csv(line, f);
+        int64_t recid = atoll(f[0].c_str());
+        std::map<int64_t, int64_t>::iterator loaded = pending.find(recid);
+        if (recid <= watermark || (loaded != pending.end() && loaded->second == 0)) {
+            continue;
+        }
+        log_row_t row;
+        row.source = (uint8_t)source;
+        row.value[COL_HOST] = host;
+        if (source == SOURCE_APPLOG) {
+            // "Rec ID","Logged At","User","Program","Severity","Message","SQLERRM"
+            f.resize(7);
+            row.value[COL_USER]     = f[2];
+            row.value[COL_PROGRAM]  = f[3];
+            row.value[COL_SEVERITY] = f[4];
+            row.value[COL_FILE]     = message_filename(f[5]);
+            row.text = f[5];
+            if (!f[6].empty()) row.text += " | SQLERRM: " + f[6];
+        } else {
+            // "Rec ID","Error Time","User","Filename","Key Value","Message","Data","SQLERRM"
+            f.resize(8);
+            row.value[COL_USER]     = f[2];
+            row.value[COL_PROGRAM]  = "IMPORT";
+            row.value[COL_SEVERITY] = "E";
+            row.value[COL_FILE]     = f[3];
+            row.text = f[5];
+            if (!f[4].empty()) row.text += " | Key: " + f[4];
+            if (!f[6].empty()) row.text += " | Data: " + f[6];
+            if (!f[7].empty()) row.text += " | SQLERRM: " + f[7];
+        }
+        if (parse_timestamp(f[1].c_str(), &row.time) == 0) {
+            row.time = 0;
+        }
+        add_row(store, &row, text_end);
+        pending[recid] = 0;
+        if (recid > high) high = recid;
+        added++;
+    }
+    if (first) {
+        // Nothing was loaded before, there is nothing earlier to wait for
+        pending.clear();
+        store->watermark[key] = high;
+    } else {
+        store->watermark[key] = next_watermark(pending, watermark, high, (int64_t)time(NULL));
+    }
+    if (pending.empty()) {
+        store->pending.erase(key);
+    }
+    return added;
+}
+
+static int64_t ingest_file(log_store_t *store, const char *path, const std::string &host, uint64_t *text_end) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        printf("Error: Could not open %s\n", path);
+        return -1;
+    }
+    char header[256] = "";
+    if (!fgets(header, sizeof(header), file)) {
+        header[0] = '\0';
+    }
+    int64_t added;
+    if (strncmp(header, "\"Rec ID\",\"Logged At\"", 20) == 0) {
+        added = ingest_export(store, file, SOURCE_APPLOG, host, text_end);
+        fclose(file);
+    } else if (strncmp(header, "\"Rec ID\",\"Error Time\"", 21) == 0) {
+        added = ingest_export(store, file, SOURCE_ERROR, host, text_end);
+        fclose(file);
+    } else {
+        fclose(file);
+        added = ingest_install_log(store, path, host, text_end);
+    }
+    return added;
+}
+
+// Read every segment of a word's postings
+static bool read_segments(FILE *post, const token_entry_t *entry, std::vector<uint32_t> &rows) {
+    rows.resize(entry->count);
+    size_t used = 0;
+    for (size_t i = 0; i < entry->segments.size(); i++) {
+        const post_segment_t &segment = entry->segments[i];
+        if (seek_file(post, (int64_t)(segment.offset * sizeof(uint32_t)), SEEK_SET) != 0
+            || fread(rows.data() + used, sizeof(uint32_t), segment.count, post) != segment.count) {
+            return false;
+        }
+        used += segment.count;
+    }
+    return true;
+}
+
+// Write the new rows to the column files, then update the time and text indexes
+static bool save_store(log_store_t *store) {
+    uint64_t first = store->saved_rows;
+    size_t added = (size_t)(store->rows - first);
+    bool ok = true;
+
+    for (int d = 0; d < DICT_COUNT && ok; d++) {
+        dictionary_t *dict = &store->dict[d];
+        FILE *file = fopen((store_file(store, dict_name[d]) + ".dict").c_str(), "a");
+        if (!file) return false;
+        for (size_t i = dict->saved; i < dict->values.size(); i++) {
+            fprintf(file, "%s\n", dict->values[i].c_str());
+        }
+        ok = fclose(file) == 0;
+        dict->saved = dict->values.size();
+        ok = ok && write_column(store_file(store, dict_name[d]) + ".col", store->column[d].data() + first, added, true);
+    }
+    ok = ok && write_column(store_file(store, "time.col"), store->time.data() + first, added, true)
+            && write_column(store_file(store, "source.col"), store->source.data() + first, added, true)
+            && write_column(store_file(store, "text.off"), store->text_offset.data() + first, added, true)
+            && write_column(store_file(store, "text.len"), store->text_length.data() + first, added, true);
+
+    FILE *text = fopen(store_file(store, "text.dat").c_str(), "ab");
+    if (!text) return false;
+    for (size_t i = 0; i < store->new_text.size(); i++) {
+        fwrite(store->new_text[i].data(), 1, store->new_text[i].size(), text);
+    }
+    ok = fclose(text) == 0 && ok;
+
+    // Time index: sort the new rows and merge them with the existing order
+    std::vector<uint32_t> new_rows(added);
+    for (size_t i = 0; i < added; i++) new_rows[i] = (uint32_t)(first + i);
+    std::vector<int64_t> &time = store->time;
+    std::stable_sort(new_rows.begin(), new_rows.end(), [&time](uint32_t a, uint32_t b) { return time[a] < time[b]; });
+    std::vector<uint32_t> merged(store->rows);
+    std::merge(store->time_order.begin(), store->time_order.end(), new_rows.begin(), new_rows.end(), merged.begin(),
+               [&time](uint32_t a, uint32_t b) { return time[a] < time[b]; });
+    store->time_order.swap(merged);
+    std::string time_index = store_file(store, "time.idx");
+    ok = ok && write_column(time_index + ".tmp", store->time_order.data(), store->time_order.size(), false)
+            && replace_file(time_index + ".tmp", time_index);
+
+    // Inverted index: each word in the new rows gets a segment appended to tokens.post and a record
+    // appended to tokens.dir, so the postings already saved are not rewritten
+    std::map<std::string, std::vector<uint32_t> > postings;
+    std::vector<std::string> tokens;
+    for (size_t i = 0; i < added; i++) {
+        tokenize(store->new_text[i], tokens);
+        for (size_t t = 0; t < tokens.size(); t++) {
+            if (tokens[t].size() < 65536) postings[tokens[t]].push_back((uint32_t)(first + i));
+        }
+    }
+    if (store->post_length < 0) {
+        int64_t length = file_length(store_file(store, "tokens.post"));
+        store->post_length = length < 0 ? 0 : length;
+    }
+    if (store->dir_length < 0) {
+        int64_t length = file_length(store_file(store, "tokens.dir"));
+        store->dir_length = length < 0 ? 0 : length;
+    }
+
+    FILE *dir_file = fopen(store_file(store, "tokens.dir").c_str(), "ab");
+    FILE *post = fopen(store_file(store, "tokens.post").c_str(), "a+b");
+    if (!dir_file || !post) {
+        if (dir_file) fclose(dir_file);
+        if (post) fclose(post);
+        return false;
+    }
+    std::vector<token_entry_t> new_entries;
+    for (std::map<std::string, std::vector<uint32_t> >::iterator it = postings.begin(); it != postings.end() && ok; ++it) {
+        std::vector<token_entry_t>::iterator entry = std::lower_bound(store->token_dir.begin(), store->token_dir.end(),
+            it->first, [](const token_entry_t &e, const std::string &value) { return e.token < value; });
+        bool found = entry != store->token_dir.end() && entry->token == it->first;
+        std::vector<uint32_t> &rows = it->second;
+        uint32_t flag = 0;
+        if (found && entry->segments.size() >= POST_MERGE_SEGMENTS) {
+            // Too many segments to read quickly, write the word's postings again as one
+            std::vector<uint32_t> all;
+            ok = read_segments(post, &*entry, all);
+            all.insert(all.end(), rows.begin(), rows.end());
+            rows.swap(all);
+            entry->segments.clear();
+            entry->count = 0;
+            flag = POST_REPLACE;
+        }
+
+        post_segment_t segment;
+        uint16_t length = (uint16_t)it->first.size();
+        uint32_t count;
+        segment.offset = (uint64_t)store->post_length / sizeof(uint32_t);
+        segment.count  = (uint32_t)rows.size();
+        count = segment.count | flag;
+        ok = ok && seek_file(post, 0, SEEK_END) == 0
+                && fwrite(rows.data(), sizeof(uint32_t), rows.size(), post) == rows.size()
+                && fwrite(&length, sizeof(length), 1, dir_file) == 1
+                && fwrite(it->first.data(), 1, length, dir_file) == length
+                && fwrite(&segment.offset, sizeof(segment.offset), 1, dir_file) == 1
+                && fwrite(&count, sizeof(count), 1, dir_file) == 1;
+        store->post_length += (int64_t)(rows.size() * sizeof(uint32_t));
+        store->dir_length += (int64_t)(sizeof(length) + length + sizeof(segment.offset) + sizeof(count));
+
+        if (found) {
+            entry->segments.push_back(segment);
+            entry->count += segment.count;
+        } else {
+            token_entry_t new_entry;
+            new_entry.token = it->first;
+            new_entry.segments.push_back(segment);
+            new_entry.count = segment.count;
+            new_entries.push_back(new_entry);
+        }
+    }
+    ok = fclose(dir_file) == 0 && ok;
+    ok = fclose(post) == 0 && ok;
+
+    // New words are in token order, merge them into the directory
+    std::vector<token_entry_t> token_dir;
+    token_dir.reserve(store->token_dir.size() + new_entries.size());
+    std::merge(store->token_dir.begin(), store->token_dir.end(), new_entries.begin(), new_entries.end(),
+               std::back_inserter(token_dir), [](const token_entry_t &a, const token_entry_t &b) { return a.token < b.token; });
+    store->token_dir.swap(token_dir);
+
+    // The row count is saved last, so a failed ingest leaves the previous rows readable
+    ok = ok && save_state(store);
+    store->saved_rows = store->rows;
+    store->new_text.clear();
+    return ok;
+}
+
+static bool read_postings(log_store_t *store, const std::string &token, std::vector<uint32_t> &rows) {
+    std::vector<token_entry_t>::iterator it = std::lower_bound(store->token_dir.begin(), store->token_dir.end(), token,
+        [](const token_entry_t &entry, const std::string &value) { return entry.token < value; });
+    rows.clear();
+    if (it == store->token_dir.end() || it->token != token) {
+        return true;
+    }
+    FILE *post = fopen(store_file(store, "tokens.post").c_str(), "rb");
+    if (!post) {
+        return false;
+    }
+    bool ok = read_segments(post, &*it, rows);
+    fclose(post);
+    return ok;
+}
+
+// Find the rows matching the filters, in time order
+static bool select_rows(log_store_t *store, const query_t *query, std::vector<uint32_t> &result) {
+    int64_t filter_id[DICT_COUNT];
+    result.clear();
+    for (int d = 0; d < DICT_COUNT; d++) {
+        filter_id[d] = -1;
+        if (query->value[d]) {
+            filter_id[d] = find_dictionary_id(&store->dict[d], query->value[d]);
+            if (filter_id[d] < 0) {
+                return true;    // Value never logged, nothing can match
+            }
+        }
+    }
+
+    // Text search: intersect the posting lists of each word, then put the rows in time order
+    std::vector<uint32_t> candidates;
+    bool use_text = query->text && query->text[0];
+    if (use_text) {
+        std::vector<std::string> tokens;
+        std::vector<uint32_t> rows, both;
+        tokenize(query->text, tokens);
+        for (size_t t = 0; t < tokens.size(); t++) {
+            if (!read_postings(store, tokens[t], rows)) return false;
+            if (t == 0) {
+                candidates.swap(rows);
+            } else {
+                both.clear();
+                std::set_intersection(candidates.begin(), candidates.end(), rows.begin(), rows.end(),
+                                      std::back_inserter(both));
+                candidates.swap(both);
+            }
+        }
+        std::vector<int64_t> &time = store->time;
+        std::stable_sort(candidates.begin(), candidates.end(), [&time](uint32_t a, uint32_t b) { return time[a] < time[b]; });
+    }
+
+    // Date range: binary search of the time index
+    std::vector<int64_t> &time = store->time;
+    std::vector<uint32_t>::iterator begin = store->time_order.begin(), end = store->time_order.end();
+    if (!use_text) {
+        begin = std::lower_bound(begin, end, query->from, [&time](uint32_t row, int64_t value) { return time[row] < value; });
+        end = std::upper_bound(begin, end, query->to, [&time](int64_t value, uint32_t row) { return value < time[row]; });
+    }
+    if (!use_text && begin == end) {
+        return true;
+    }
+    const uint32_t *rows = use_text ? candidates.data() : &*begin;
+    size_t count = use_text ? candidates.size() : (size_t)(end - begin);
+
+    for (size_t i = 0; i < count; i++) {
+        uint32_t row = rows[i];
+        if (time[row] < query->from || time[row] > query->to) continue;
+        if (query->source >= 0 && store->source[row] != query->source) continue;
+        bool match = true;
+        for (int d = 0; d < DICT_COUNT && match; d++) {
+            match = filter_id[d] < 0 || store->column[d][row] == (uint32_t)filter_id[d];
+        }
+        if (match) result.push_back(row);
+    }
+    return true;
+}
+
+static std::string row_text(FILE *text, log_store_t *store, uint32_t row) {
+    std::string value(store->text_length[row], ' ');
+    if (!value.empty() && (seek_file(text, (int64_t)store->text_offset[row], SEEK_SET) != 0
+                           || fread(&value[0], 1, value.size(), text) != value.size())) {
+        value.clear();
+    }
+    return value;
+}
+
+static void print_rows(log_store_t *store, const std::vector<uint32_t> &rows, int limit) {
+    FILE *text = fopen(store_file(store, "text.dat").c_str(), "rb");
+    char timestamp[32];
+    printf("%-19s %-10s %-20s %-3s %-12s %-20s %s\n", "Time", "Host", "Program", "Sev", "User", "File", "Message");
+    for (size_t i = 0; i < rows.size() && (limit <= 0 || (int)i < limit); i++) {
+        uint32_t row = rows[i];
+        format_timestamp(store->time[row], timestamp, sizeof(timestamp), false);
+        printf("%-19s %-10s %-20s %-3s %-12s %-20s %s\n", timestamp,
+               store->dict[COL_HOST].values[store->column[COL_HOST][row]].c_str(),
+               store->dict[COL_PROGRAM].values[store->column[COL_PROGRAM][row]].c_str(),
+               store->dict[COL_SEVERITY].values[store->column[COL_SEVERITY][row]].c_str(),
+               store->dict[COL_USER].values[store->column[COL_USER][row]].c_str(),
+               store->dict[COL_FILE].values[store->column[COL_FILE][row]].c_str(),
+               text ? row_text(text, store, row).c_str() : "");
+    }
+    if (text) fclose(text);
+}
+
+// Column number for a -by field: dictionary columns, then source, hour and day
+static int group_field(const char *name, size_t length) {
+    static const char *extra[3] = { "source", "hour", "day" };
+    for (int d = 0; d < DICT_COUNT; d++) {
+        if (strlen(dict_name[d]) == length && strncmp(name, dict_name[d], length) == 0) return d;
+    }
+    for (int i = 0; i < 3; i++) {
+        if (strlen(extra[i]) == length && strncmp(name, extra[i], length) == 0) return DICT_COUNT + i;
+    }
+    return -1;
+}
+
+static int64_t group_value(log_store_t *store, int field, uint32_t row) {
+    if (field < DICT_COUNT) return store->column[field][row];
+    if (field == DICT_COUNT) return store->source[row];
+    int64_t bucket = field == DICT_COUNT + 1 ? 3600 : 86400;
+    int64_t t = store->time[row];
+    return (t >= 0 ? t : t - bucket + 1) / bucket * bucket;
+}
+
+static std::string group_label(log_store_t *store, int field, int64_t value) {
+    char buffer[32];
+    if (field < DICT_COUNT) return store->dict[field].values[(size_t)value];
+    if (field == DICT_COUNT) return source_name[value];
+    format_timestamp(value, buffer, sizeof(buffer), true);
+    if (field == DICT_COUNT + 2) buffer[10] = '\0';
+    return buffer;
+}
+
+static bool count_rows(log_store_t *store, const std::vector<uint32_t> &rows, const char *by, int top) {
+    int fields[2] = { -1, -1 };
+    int field_count = 0;
+    const char *p = by;
+    while (*p && field_count < 2) {
+        size_t length = strcspn(p, ",");
+        fields[field_count] = group_field(p, length);
+        if (fields[field_count] < 0) {
+            printf("Error: Unknown field in -by %s\n", by);
+            return false;
+        }
+        field_count++;
+        p += length;
+        if (*p == ',') p++;
+    }
+    if (field_count == 0) {
+        printf("Error: count needs -by field[,field]\n");
+        return false;
+    }
+
+    std::map<std::pair<int64_t, int64_t>, int64_t> groups;
+    for (size_t i = 0; i < rows.size(); i++) {
+        int64_t first = group_value(store, fields[0], rows[i]);
+        int64_t second = field_count > 1 ? group_value(store, fields[1], rows[i]) : 0;
+        groups[std::make_pair(first, second)]++;
+    }
+
+    std::vector<std::pair<std::pair<int64_t, int64_t>, int64_t> > sorted(groups.begin(), groups.end());
+    if (top > 0) {
+        std::stable_sort(sorted.begin(), sorted.end(),
+            [](const std::pair<std::pair<int64_t, int64_t>, int64_t> &a,
+               const std::pair<std::pair<int64_t, int64_t>, int64_t> &b) { return a.second > b.second; });
+        if ((int)sorted.size() > top) sorted.resize(top);
+    }
+    for (size_t i = 0; i < sorted.size(); i++) {
+        std::string label = group_label(store, fields[0], sorted[i].first.first);
+        if (field_count > 1) label += "  " + group_label(store, fields[1], sorted[i].first.second);
+        printf("%10lld  %s\n", (long long)sorted[i].second, label.c_str());
+    }
+    return true;
+}
+
+static void usage() {
+    printf("Usage:\n");
+    printf("  logq ingest <store> [-host name] <file>...\n");
+    printf("  logq search <store> [filters] [-limit n]\n");
+    printf("  logq count  <store> [filters] -by field[,field] [-top n]\n");
+    printf("  logq stats  <store>\n");
+    printf("  logq watermark <store> applog|importerror [-host name]\n");
+    printf("Filters: -program -severity -user -file -host -source -from -to -text\n");
+    printf("Fields:  program severity user file host source hour day\n");
+}
+
+static bool parse_query(int argc, char *argv[], query_t *query) {
+    memset(query, 0, sizeof(*query));
+    query->source = -1;
+    query->from   = INT64_MIN;
+    query->to     = INT64_MAX;
+    query->limit  = 100;
+
+    for (int i = 3; i < argc; i += 2) {
+        if (i + 1 >= argc) return false;
+        const char *name = argv[i] + 1;
+        const char *value = argv[i + 1];
+        int d;
+        for (d = 0; d < DICT_COUNT && strcmp(name, dict_name[d]) != 0; d++);
+        if (argv[i][0] == '-' && d < DICT_COUNT) {
+            query->value[d] = value;
+        } else if (strcmp(argv[i], "-source") == 0) {
+            for (int s = 0; s < 3; s++) {
+                if (strcmp(value, source_name[s]) == 0) query->source = s;
+            }
+            if (query->source < 0) return false;
+        } else if (strcmp(argv[i], "-from") == 0) {
+            if (!parse_timestamp(value, &query->from)) return false;
+        } else if (strcmp(argv[i], "-to") == 0) {
+            int used = parse_timestamp(value, &query->to);
+            if (!used) return false;
+            if (value[used] == '\0' && !strchr(value, ':')) query->to += 86399;   // Whole day
+        } else if (strcmp(argv[i], "-text") == 0) {
+            query->text = value;
+        } else if (strcmp(argv[i], "-limit") == 0) {
+            query->limit = atoi(value);
+        } else if (strcmp(argv[i], "-top") == 0) {
+            query->top = atoi(value);
+        } else if (strcmp(argv[i], "-by") == 0) {
+            query->by = value;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// RECID every APPLOG or IMPORTERROR row up to has been loaded for the host, 0 if there is no store yet
+static bool print_watermark(log_store_t *store, int argc, char *argv[]) {
+    std::string host = "local";
+    if (argc == 6 && strcmp(argv[4], "-host") == 0) {
+        host = argv[5];
+    } else if (argc != 4) {
+        return false;
+    }
+    if (strcmp(argv[3], source_name[SOURCE_APPLOG]) != 0 && strcmp(argv[3], source_name[SOURCE_ERROR]) != 0) {
+        return false;
+    }
+    store->dir = argv[2];
+    load_state(store);
+    std::string key = std::string(argv[3]) + " " + host;
+    printf("%lld\n", (long long)(store->watermark.count(key) ? store->watermark[key] : 0));
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    log_store_t store;
+    int status = -1;
+
+    if (argc < 3) {
+        usage();
+        return status;
+    }
+    const char *command = argv[1];
+    if (strcmp(command, "watermark") == 0) {
+        if (!print_watermark(&store, argc, argv)) {
+            usage();
+            return status;
+        }
+        return 0;
+    }
+    bool ingest = strcmp(command, "ingest") == 0;
+    if (!open_store(&store, argv[2], ingest)) {
+        return status;
+    }
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    if (ingest) {
+        std::string host = "local";
+        uint64_t text_end = text_size(&store);
+        status = 0;
+        for (int i = 3; i < argc; i++) {
+            if (strcmp(argv[i], "-host") == 0 && i + 1 < argc) {
+                host = argv[++i];
+                continue;
+            }
+            int64_t added = ingest_file(&store, argv[i], host, &text_end);
+            if (added < 0) {
+                status = -1;
+            } else {
+                printf("%s: %lld new row(s)\n", argv[i], (long long)added);
+            }
+        }
+        if (!save_store(&store)) {
+            printf("Error: Could not save log store %s\n", argv[2]);
+            status = -1;
+        }
+        printf("Store holds %llu row(s).\n", (unsigned long long)store.rows);
+    } else if (strcmp(command, "stats") == 0) {
+        printf("Rows     : %llu\n", (unsigned long long)store.rows);
+        printf("Words    : %llu\n", (unsigned long long)store.token_dir.size());
+        for (int d = 0; d < DICT_COUNT; d++) {
+            printf("%-9s: %llu distinct\n", dict_name[d], (unsigned long long)store.dict[d].values.size());
+        }
+        status = 0;
+    } else if (strcmp(command, "search") == 0 || strcmp(command, "count") == 0) {
+        query_t query;
+        std::vector<uint32_t> rows;
+        if (!parse_query(argc, argv, &query)) {
+            usage();
+        } else if (select_rows(&store, &query, rows)) {
+            if (command[0] == 's') {
+                print_rows(&store, rows, query.limit);
+                status = 0;
+            } else if (count_rows(&store, rows, query.by ? query.by : "", query.top)) {
+                status = 0;
+            }
+            printf("%llu matching row(s) in %.1f ms\n", (unsigned long long)rows.size(),
+                   std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+    } else {
+        usage();
+    }
+    return status;
+}
@@ -0,0 +1,573 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <algorithm>
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>        // For GetProcessMemoryInfo()
+#else
+#include <sys/resource.h> // For getrusage()
+#endif
+#include "order_schema.h"
+#include "order_import.h"
+
+/*
+  Program Name   : ordbench.c
+  Description    : Order import and export benchmark
+  Copyright      : Bond & Pollard Ltd 2025
+  Auther         : agent
+  Date           : 18 October 2026
+
+
+  Measures order import and export throughput without an Oracle database,
+  using the order schema emulator in order_schema.c.
+
+  The benchmark:
+  Creates the DATA_IN, DATA_IN\processed, DATA_IN\error and DATA_OUT directories under -dir.
+  Seeds customers, sales reps, products and prices.
+  Generates ORDER*.csv files in DATA_IN, in the format described in the
+  Import Order CSV Tech Spec. -errors gives the percentage of files with an invalid row.
+  Imports each file with ord_imp (IMPORT.ORD_IMP): load, validate, insert.
+  Exports all orders with export_orders (EXPORT.ORDERS).
+  Reports rows/sec, p50/p99 latency per file, time in each stage and peak memory.
+
+  With -baseline, results are compared with a previous run saved with -save, and the
+  program exits with status 1 if throughput fell, or p99 latency rose, by more than
+  -tolerance percent.
+
+  With -workers, measures how the concurrent import model in order_import.c would
+  scale instead. Like the rest of the benchmark it runs against the emulator only.
+  The files are generated again for each worker count in the list and imported with
+  import_order_files(), and once more imported one at a time with ord_imp() as the
+  reference. Each run must give the same exported orders, IMPORTERROR and APPLOG
+  rows as the reference, or the program exits with status 1.
+
+  Usage: ordbench [-files n] [-orders n] [-items n] [-customers n] [-products n]
+                  [-errors pct] [-dir path] [-ordid-max n]
+                  [-save file] [-baseline file] [-tolerance pct]
+                  [-workers n,n,...] [-shards n]
+
+  Build: g++ -O2 -o ordbench.exe ordbench.c order_schema.c order_import.c -lpsapi
+
+ */
+
+
+#define MAX_WORKER_COUNTS  16
+
+typedef struct {
+    int         files;
+    int         orders;
+    int         items;
+    int         customers;
+    int         products;
+    int         error_pct;
+    int         ordid_max;
+    int         tolerance_pct;
+    const char *dir;
+    const char *save_file;
+    const char *baseline_file;
+    int         workers[MAX_WORKER_COUNTS];
+    int         worker_counts;     // 0 unless -workers was given
+    int         shards;
+} bench_options_t;
+
+typedef struct {
+    int64_t     files_ok;
+    int64_t     files_failed;
+    int64_t     import_rows;
+    double      import_secs;
+    double      import_rows_per_sec;
+    double      p50_ms;
+    double      p99_ms;
+    double      load_secs;
+    double      validate_secs;
+    double      insert_secs;
+    int64_t     export_rows;
+    double      export_secs;
+    double      export_rows_per_sec;
+    double      peak_mb;
+} bench_result_t;
+
+typedef struct {
+    int         workers;           // 0 for ord_imp one file at a time
+    int64_t     files_ok;
+    int64_t     files_failed;
+    int64_t     import_rows;
+    int64_t     importerrors;
+    int64_t     applogs;
+    double      import_secs;
+    double      read_secs;
+    double      validate_secs;
+    double      commit_secs;
+    bool        same;              // Same result as ord_imp
+} scale_result_t;
+
+
+static void usage() {
+    printf("Usage: ordbench [-files n] [-orders n] [-items n] [-customers n] [-products n]\n");
+    printf("                [-errors pct] [-dir path] [-ordid-max n]\n");
+    printf("                [-save file] [-baseline file] [-tolerance pct]\n");
+    printf("                [-workers n,n,...] [-shards n]\n");
+}
+
+// A list of worker counts such as 1,2,4,8,16,32
+static bool parse_workers(const char *value, bench_options_t *options) {
+    options->worker_counts = 0;
+    while (*value) {
+        char *end;
+        long workers = strtol(value, &end, 10);
+        if (end == value || workers < 1 || workers > 256 || options->worker_counts == MAX_WORKER_COUNTS) {
+            return false;
+        }
+        options->workers[options->worker_counts++] = (int)workers;
+        value = *end == ',' ? end + 1 : end;
+        if (*end && *end != ',') {
+            return false;
+        }
+    }
+    return options->worker_counts > 0;
+}
+
+static bool parse_options(int argc, char *argv[], bench_options_t *options) {
+    options->files         = 100;
+    options->orders        = 20;
+    options->items         = 5;
+    options->customers     = 1000;
+    options->products      = 500;
+    options->error_pct     = 0;
+    options->ordid_max     = ORDID_MAX;
+    options->tolerance_pct = 10;
+    options->dir           = "ordbench_data";
+    options->save_file     = NULL;
+    options->baseline_file = NULL;
+    options->worker_counts = 0;
+    options->shards        = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const char *name = argv[i];
+        const char *value = argv[++i];
+        if      (strcmp(name, "-files") == 0)     options->files = atoi(value);
+        else if (strcmp(name, "-orders") == 0)    options->orders = atoi(value);
+        else if (strcmp(name, "-items") == 0)     options->items = atoi(value);
+        else if (strcmp(name, "-customers") == 0) options->customers = atoi(value);
+        else if (strcmp(name, "-products") == 0)  options->products = atoi(value);
+        else if (strcmp(name, "-errors") == 0)    options->error_pct = atoi(value);
+        else if (strcmp(name, "-ordid-max") == 0) options->ordid_max = atoi(value);
+        else if (strcmp(name, "-tolerance") == 0) options->tolerance_pct = atoi(value);
+        else if (strcmp(name, "-dir") == 0)       options->dir = value;
+        else if (strcmp(name, "-save") == 0)      options->save_file = value;
+        else if (strcmp(name, "-baseline") == 0)  options->baseline_file = value;
+        else if (strcmp(name, "-shards") == 0)    options->shards = atoi(value);
+        else if (strcmp(name, "-workers") == 0) {
+            if (!parse_workers(value, options)) return false;
+        }
+        else return false;
+    }
+    return options->files > 0 && options->orders > 0 && options->items > 0
+        && options->customers > 0 && options->products > 0;
+}
+
+static double peak_memory_mb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize / (1024.0 * 1024.0);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0;    // Kilobytes on Linux
+#endif
+}
+
+// Seed the reference data the order files refer to
+static void seed_schema(order_schema_t *schema, const bench_options_t *options) {
+    static const int32_t empno[] = { 7499, 7521, 7654, 7698, 7844 };
+    static const char *ename[]   = { "ALLEN", "WARD", "MARTIN", "BLAKE", "TURNER" };
+    char name[32];
+
+    for (int i = 0; i < 5; i++) {
+        insert_emp(schema, empno[i], ename[i]);
+    }
+    for (int i = 0; i < options->customers; i++) {
+        snprintf(name, sizeof(name), "CUSTOMER %d", i + 1);
+        insert_customer(schema, 0, name, empno[i % 5]);
+    }
+    for (int i = 0; i < options->products; i++) {
+        snprintf(name, sizeof(name), "PRODUCT %d", i + 1);
+        int32_t prodid = insert_product(schema, 0, name);
+        int64_t stdprice = 100 + (i * 37) % 5000;
+        insert_price(schema, prodid, stdprice, stdprice * 8 / 10, 20000101, 0);
+    }
+}
+
+static void file_name(char *buffer, size_t size, int file_no) {
+    snprintf(buffer, size, "ORDER%05d.csv", file_no);
+}
+
+// Write ORDER<n>.csv into DATA_IN. Files picked for errors get one row with an unknown product.
+static bool generate_file(order_schema_t *schema, const bench_options_t *options, int file_no, bool with_error) {
+    char filename[32];
+    file_name(filename, sizeof(filename), file_no);
+    std::string path = make_path(schema->data_in, filename);
+
+    FILE *file = fopen(path.c_str(), "w");
+    if (!file) {
+        printf("Error: Cannot open %s for writing!\n", path.c_str());
+        return false;
+    }
+    fprintf(file, "\"Ord Ref\",\"Order Date\",\"Comm Plan\",\"Customer ID\",\"Ship Date\",\"Product ID\",\"Qty\"\n");
+    for (int o = 0; o < options->orders; o++) {
+        int order_no = (file_no - 1) * options->orders + o;
+        int custid = 109 + order_no % options->customers;
+        int day = 1 + order_no % 28, month = 1 + order_no % 12;
+        for (int i = 0; i < options->items; i++) {
+            int prodid = 200381 + (order_no * 7 + i * 13) % options->products;
+            if (with_error && o == options->orders / 2 && i == 0) {
+                prodid = 999999;
+            }
+            fprintf(file, "\"B%08d\",%02d/%02d/2025,\"%c\",%d,%02d/%02d/2026,%d,%d\n", order_no, day, month,
+                    'A' + order_no % 3, custid, day, month, prodid, 1 + (order_no + i) % 50);
+        }
+    }
+    fclose(file);
+    return true;
+}
+
+// Remove output left by a previous run so files can be moved to processed and error again
+static void remove_previous_run(order_schema_t *schema, const bench_options_t *options) {
+    char filename[32];
+    for (int f = 1; f <= options->files; f++) {
+        file_name(filename, sizeof(filename), f);
+        remove(make_path(schema->data_in, filename).c_str());
+        remove(make_path(schema->data_in_processed, filename).c_str());
+        remove(make_path(schema->data_in_error, filename).c_str());
+    }
+}
+
+static double percentile_ms(std::vector<int64_t> &latency_us, int pct) {
+    if (latency_us.empty()) {
+        return 0;
+    }
+    std::sort(latency_us.begin(), latency_us.end());
+    size_t rank = (latency_us.size() * pct + 99) / 100;   // Nearest rank
+    if (rank < 1) rank = 1;
+    return latency_us[rank - 1] / 1000.0;
+}
+
+// A seeded schema with the order files generated in DATA_IN, or NULL on error
+static order_schema_t *prepare_run(const bench_options_t *options) {
+    order_schema_t *schema = new order_schema_t();
+    schema_init(schema, options->dir);
+    schema->ordid_max = options->ordid_max;
+    if (!schema_create_directories(schema)) {
+        printf("Error: Could not create the data directories under %s\n", options->dir);
+        delete schema;
+        return NULL;
+    }
+    remove_previous_run(schema, options);
+    seed_schema(schema, options);
+
+    printf("Generating %d files of %d orders with %d items...\n", options->files, options->orders, options->items);
+    for (int f = 1; f <= options->files; f++) {
+        bool with_error = options->error_pct > 0 && (f * options->error_pct) / 100 != ((f - 1) * options->error_pct) / 100;
+        if (!generate_file(schema, options, f, with_error)) {
+            delete schema;
+            return NULL;
+        }
+    }
+    return schema;
+}
+
+static bool run_benchmark(const bench_options_t *options, bench_result_t *result) {
+    std::vector<int64_t> latency_us;
+    char filename[32];
+
+    memset(result, 0, sizeof(*result));
+    order_schema_t *schema = prepare_run(options);
+    if (!schema) {
+        return false;
+    }
+
+    printf("Importing...\n");
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int f = 1; f <= options->files; f++) {
+        ord_imp_stats_t stats;
+        file_name(filename, sizeof(filename), f);
+        std::chrono::steady_clock::time_point file_start = std::chrono::steady_clock::now();
+        bool ok = ord_imp(schema, filename, &stats);
+        latency_us.push_back(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - file_start).count());
+        if (ok) {
+            result->files_ok++;
+        } else {
+            result->files_failed++;
+        }
+        result->import_rows   += stats.rows;
+        result->load_secs     += stats.load_us / 1e6;
+        result->validate_secs += stats.validate_us / 1e6;
+        result->insert_secs   += stats.insert_us / 1e6;
+    }
+    result->import_secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("Exporting...\n");
+    start = std::chrono::steady_clock::now();
+    result->export_rows = export_orders(schema, NULL);
+    result->export_secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    result->import_rows_per_sec = result->import_secs > 0 ? result->import_rows / result->import_secs : 0;
+    result->export_rows_per_sec = result->export_secs > 0 ? result->export_rows / result->export_secs : 0;
+    result->p50_ms  = percentile_ms(latency_us, 50);
+    result->p99_ms  = percentile_ms(latency_us, 99);
+    result->peak_mb = peak_memory_mb();
+
+    if (result->files_failed > 0) {
+        printf("%lld file(s) rejected, %lld IMPORTERROR row(s), %lld APPLOG row(s).\n", (long long)result->files_failed,
+               (long long)importerror_count(schema), (long long)schema->applog.size());
+    }
+    delete schema;
+    return result->export_rows >= 0;
+}
+
+// Import the files with import_order_files() on workers threads, or with ord_imp() one at a
+// time if workers is 0, and export the orders to export_file in DATA_OUT
+static bool run_scaling(const bench_options_t *options, int workers, const char *export_file, scale_result_t *result) {
+    char filename[32];
+
+    memset(result, 0, sizeof(*result));
+    result->workers = workers;
+    order_schema_t *schema = prepare_run(options);
+    if (!schema) {
+        return false;
+    }
+
+    if (workers == 0) {
+        printf("Importing with ord_imp...\n");
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int f = 1; f <= options->files; f++) {
+            ord_imp_stats_t stats;
+            file_name(filename, sizeof(filename), f);
+            if (ord_imp(schema, filename, &stats)) {
+                result->files_ok++;
+            } else {
+                result->files_failed++;
+            }
+            result->import_rows   += stats.rows;
+            result->read_secs     += stats.load_us / 1e6;
+            result->validate_secs += stats.validate_us / 1e6;
+            result->commit_secs   += stats.insert_us / 1e6;
+        }
+        result->import_secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    } else {
+        import_options_t import_options;
+        import_stats_t stats;
+        import_options.workers = workers;
+        import_options.shards  = options->shards;
+        printf("Importing with %d worker(s)...\n", workers);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        import_order_files(schema, &import_options, &stats);
+        result->import_secs   = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        result->files_ok      = stats.files_ok;
+        result->files_failed  = stats.files_failed;
+        result->import_rows   = stats.rows;
+        result->read_secs     = stats.read_us / 1e6;
+        result->validate_secs = stats.validate_us / 1e6;
+        result->commit_secs   = stats.commit_us / 1e6;
+    }
+
+    result->importerrors = importerror_count(schema);
+    result->applogs      = (int64_t)schema->applog.size();
+    bool ok = export_orders(schema, export_file) >= 0;
+    delete schema;
+    return ok;
+}
+
+static bool same_file(const std::string &path1, const std::string &path2) {
+    FILE *file1 = fopen(path1.c_str(), "rb");
+    FILE *file2 = fopen(path2.c_str(), "rb");
+    bool same = file1 && file2;
+    char buffer1[65536], buffer2[65536];
+    while (same) {
+        size_t len1 = fread(buffer1, 1, sizeof(buffer1), file1);
+        size_t len2 = fread(buffer2, 1, sizeof(buffer2), file2);
+        same = len1 == len2 && memcmp(buffer1, buffer2, len1) == 0;
+        if (len1 == 0) break;
+    }
+    if (file1) fclose(file1);
+    if (file2) fclose(file2);
+    return same;
+}
+
+// Run the ord_imp reference then each worker count. Returns false if a run failed or differed.
+static bool run_scaling_benchmark(const bench_options_t *options, std::vector<scale_result_t> &results) {
+    char export_file[32];
+    order_schema_t paths;
+    schema_init(&paths, options->dir);
+    bool ok = true;
+
+    for (int i = -1; i < options->worker_counts; i++) {
+        scale_result_t result;
+        int workers = i < 0 ? 0 : options->workers[i];
+        snprintf(export_file, sizeof(export_file), "orders_workers%d.csv", workers);
+        if (!run_scaling(options, workers, export_file, &result)) {
+            results.clear();
+            return false;
+        }
+        if (workers == 0) {
+            result.same = true;
+        } else {
+            const scale_result_t &reference = results[0];
+            result.same = result.files_ok == reference.files_ok && result.importerrors == reference.importerrors
+                && result.applogs == reference.applogs
+                && same_file(make_path(paths.data_out, "orders_workers0.csv"), make_path(paths.data_out, export_file));
+        }
+        ok = ok && result.same;
+        results.push_back(result);
+    }
+    return ok;
+}
+
+static void print_scaling(const bench_options_t *options, const std::vector<scale_result_t> &results) {
+    printf("\nORDER IMPORT SCALING BENCHMARK\n");
+    printf("==============================\n");
+    printf("Files %d, orders per file %d, items per order %d, shards %s\n", options->files, options->orders,
+           options->items, options->shards > 0 ? std::to_string(options->shards).c_str() : "one per worker");
+    printf("%-8s %10s %12s %8s %9s %10s %9s  %s\n", "Workers", "Import s", "Rows/sec", "Speedup",
+           "Read s", "Validate s", "Commit s", "Result");
+    for (size_t i = 0; i < results.size(); i++) {
+        const scale_result_t &result = results[i];
+        double rate = result.import_secs > 0 ? result.import_rows / result.import_secs : 0;
+        double speedup = result.import_secs > 0 ? results[0].import_secs / result.import_secs : 0;
+        printf("%-8s %10.3f %12.0f %7.2fx %9.3f %10.3f %9.3f  %s\n",
+               result.workers ? std::to_string(result.workers).c_str() : "ord_imp", result.import_secs, rate, speedup,
+               result.read_secs, result.validate_secs, result.commit_secs,
+               result.workers == 0 ? "reference" : result.same ? "same" : "DIFFERENT");
+    }
+    printf("Files imported       : %lld\n", (long long)results[0].files_ok);
+    printf("Files rejected       : %lld\n", (long long)results[0].files_failed);
+    printf("Peak memory          : %.1f MB\n", peak_memory_mb());
+}
+
+static void print_result(const bench_result_t *result) {
+    printf("\nORDER IMPORT/EXPORT BENCHMARK\n");
+    printf("=============================\n");
+    printf("Files imported       : %lld\n", (long long)result->files_ok);
+    printf("Files rejected       : %lld\n", (long long)result->files_failed);
+    printf("Rows loaded          : %lld\n", (long long)result->import_rows);
+    printf("Import time          : %.3f s\n", result->import_secs);
+    printf("Import rows/sec      : %.0f\n", result->import_rows_per_sec);
+    printf("File latency p50     : %.3f ms\n", result->p50_ms);
+    printf("File latency p99     : %.3f ms\n", result->p99_ms);
+    printf("  Load               : %.3f s\n", result->load_secs);
+    printf("  Validate           : %.3f s\n", result->validate_secs);
+    printf("  Insert             : %.3f s\n", result->insert_secs);
+    printf("Rows exported        : %lld\n", (long long)result->export_rows);
+    printf("Export time          : %.3f s\n", result->export_secs);
+    printf("Export rows/sec      : %.0f\n", result->export_rows_per_sec);
+    printf("Peak memory          : %.1f MB\n", result->peak_mb);
+}
+
+static bool save_result(const char *filename, const bench_result_t *result) {
+    FILE *file = fopen(filename, "w");
+    if (!file) {
+        printf("Error: Cannot open %s for writing!\n", filename);
+        return false;
+    }
+    fprintf(file, "import_rows_per_sec=%.0f\n", result->import_rows_per_sec);
+    fprintf(file, "export_rows_per_sec=%.0f\n", result->export_rows_per_sec);
+    fprintf(file, "p50_ms=%.3f\n", result->p50_ms);
+    fprintf(file, "p99_ms=%.3f\n", result->p99_ms);
+    fprintf(file, "peak_mb=%.1f\n", result->peak_mb);
+    fclose(file);
+    printf("Results saved to %s\n", filename);
+    return true;
+}
+
+// Compare with a saved run. Returns the number of regressions found, or -1 on error.
+static int compare_baseline(const char *filename, const bench_result_t *result, int tolerance_pct) {
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        printf("Error: Cannot open baseline %s\n", filename);
+        return -1;
+    }
+    double import_rate = 0, export_rate = 0, p99 = 0, value;
+    char line[128], name[64];
+    while (fgets(line, sizeof(line), file)) {
+        if (sscanf(line, "%63[^=]=%lf", name, &value) != 2) continue;
+        if (strcmp(name, "import_rows_per_sec") == 0) import_rate = value;
+        else if (strcmp(name, "export_rows_per_sec") == 0) export_rate = value;
+        else if (strcmp(name, "p99_ms") == 0) p99 = value;
+    }
+    fclose(file);
+
+    int regressions = 0;
+    double allowed = tolerance_pct / 100.0;
+    printf("\nBASELINE COMPARISON (tolerance %d%%)\n", tolerance_pct);
+    printf("====================================\n");
+    printf("Import rows/sec      : %.0f baseline %.0f\n", result->import_rows_per_sec, import_rate);
+    printf("Export rows/sec      : %.0f baseline %.0f\n", result->export_rows_per_sec, export_rate);
+    printf("File latency p99     : %.3f ms baseline %.3f ms\n", result->p99_ms, p99);
+    if (result->import_rows_per_sec < import_rate * (1 - allowed)) {
+        printf("REGRESSION: import throughput\n");
+        regressions++;
+    }
+    if (result->export_rows_per_sec < export_rate * (1 - allowed)) {
+        printf("REGRESSION: export throughput\n");
+        regressions++;
+    }
+    if (p99 > 0 && result->p99_ms > p99 * (1 + allowed)) {
+        printf("REGRESSION: p99 file latency\n");
+        regressions++;
+    }
+    return regressions;
+}
+
+int main(int argc, char *argv[]) {
+    bench_options_t options;
+    bench_result_t result;
+    int status = 0;
+
+    if (!parse_options(argc, argv, &options)) {
+        usage();
+        return -1;
+    }
+    if ((int64_t)options.files * options.orders > options.ordid_max - 622 + 1) {
+        printf("Warning: %lld orders will exceed the maximum ORDID %d, use -ordid-max to raise it.\n",
+               (long long)options.files * options.orders, options.ordid_max);
+    }
+
+    if (options.worker_counts > 0) {
+        std::vector<scale_result_t> results;
+        bool same = run_scaling_benchmark(&options, results);
+        if (results.empty()) {
+            return -1;
+        }
+        print_scaling(&options, results);
+        if (!same) {
+            printf("REGRESSION: concurrent import differs from ord_imp\n");
+            return 1;
+        }
+        return 0;
+    }
+
+    if (!run_benchmark(&options, &result)) {
+        return -1;
+    }
+    print_result(&result);
+
+    if (options.save_file && !save_result(options.save_file, &result)) {
+        status = -1;
+    }
+    if (options.baseline_file) {
+        int regressions = compare_baseline(options.baseline_file, &result, options.tolerance_pct);
+        if (regressions != 0) {
+            status = regressions < 0 ? -1 : 1;
+        }
+    }
+    return status;
+}
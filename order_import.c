@@ -0,0 +1,389 @@
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#ifdef _WIN32
+#include <windows.h>      // For FindFirstFile()
+#else
+#include <dirent.h>       // For opendir()
+#include <strings.h>      // For strcasecmp()
+#endif
+#include "order_import.h"
+
+/*
+  Program Name   : order_import.c
+  Description    : Concurrent sharded order import model for the order schema emulator
+  Copyright      : Bond & Pollard Ltd 2025
+  Auther         : agent
+  Date           : 18 October 2026
+
+
+  Implements the import coordinator described in order_import.h, using the
+  steps of IMPORT.ORD_VALID and IMPORT.ORD_IMP exported by order_schema.c.
+  A model of the sharded Oracle import in import_order.bat, see order_import.h.
+  Tested by order_import_test.c.
+
+ */
+
+
+// An ORD_VALID error found by a shard, row is relative to the start of the order
+typedef struct {
+    int32_t     row;
+    row_error_t error;
+} unit_error_t;
+
+// The rows of one order in a file
+typedef struct {
+    int32_t             first_row;
+    int32_t             row_count;
+    std::string         ordref;       // Empty for rows before the first ORDREF in the file
+    ord_valid_state_t   state;        // ORD_VALID locals before the first row
+
+    // Filled in by the shard
+    std::vector<unit_error_t> errors;
+    ord_t               order;
+    int                 failure;      // FAIL_PRECISION or FAIL_NULL_ORDID
+    int32_t             failed_row;
+} import_unit_t;
+
+typedef struct {
+    std::string                 name;
+    int                         read_result;  // read_csv()
+    int64_t                     records;
+    std::vector<std::string>    rows;         // Records ORD_VALID selects
+    std::vector<import_unit_t>  units;
+} import_file_t;
+
+typedef struct {
+    int32_t     file;
+    int32_t     unit;
+} unit_ref_t;
+
+// State shared by the threads of a stage
+typedef struct {
+    const order_schema_t                   *schema;
+    std::vector<import_file_t>             *files;
+    std::vector<std::vector<unit_ref_t> >  *shards;
+    std::atomic<size_t>                     next;
+} batch_t;
+
+
+static int64_t elapsed_us(std::chrono::steady_clock::time_point start) {
+    return (int64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool less_ignore_case(const std::string &a, const std::string &b) {
+    for (size_t i = 0; i < a.size() && i < b.size(); i++) {
+        int ca = tolower((unsigned char)a[i]), cb = tolower((unsigned char)b[i]);
+        if (ca != cb) return ca < cb;
+    }
+    return a.size() < b.size();
+}
+
+#ifndef _WIN32
+static bool is_order_file(const char *name) {
+    size_t len = strlen(name);
+    return len >= 9 && strncasecmp(name, "ORDER", 5) == 0 && strcasecmp(name + len - 4, ".CSV") == 0;
+}
+#endif
+
+bool list_order_files(order_schema_t *schema, std::vector<std::string> &filenames) {
+    filenames.clear();
+#ifdef _WIN32
+    WIN32_FIND_DATAA found;
+    HANDLE handle = FindFirstFileA(make_path(schema->data_in, "ORDER*.CSV").c_str(), &found);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return GetLastError() == ERROR_FILE_NOT_FOUND;
+    }
+    do {
+        if (!(found.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+            filenames.push_back(found.cFileName);
+        }
+    } while (FindNextFileA(handle, &found));
+    FindClose(handle);
+#else
+    DIR *dir = opendir(schema->data_in.c_str());
+    if (!dir) {
+        return false;
+    }
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (is_order_file(entry->d_name) && entry->d_type != DT_DIR) {
+            filenames.push_back(entry->d_name);
+        }
+    }
+    closedir(dir);
+#endif
+    std::sort(filenames.begin(), filenames.end(), less_ignore_case);
+    return true;
+}
+
+// FNV-1a, the same shard for an ORDREF on every platform
+static uint32_t ordref_hash(const std::string &ordref) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < ordref.size(); i++) {
+        hash = (hash ^ (unsigned char)ordref[i]) * 16777619u;
+    }
+    return hash;
+}
+
+// Read a file and split its rows into orders the way ORD_IMP groups them
+static void read_file(const order_schema_t *schema, import_file_t *file) {
+    std::vector<std::string> records;
+    file->read_result = read_csv(make_path(schema->data_in, file->name.c_str()), records);
+    file->records = (int64_t)records.size();
+    if (file->read_result <= 0) {
+        return;     // When LOAD_CSV fails part way ORD_IMP has no rows to process
+    }
+
+    std::vector<std::string> f;
+    std::string prev_ordref = " ";
+    ord_valid_state_t state;
+    state.orderdate = 0;
+    state.shipdate  = 0;
+
+    for (size_t i = 0; i < records.size(); i++) {
+        if (!is_order_record(records[i])) {
+            continue;
+        }
+        split_fields(records[i], ',', f);
+        f.resize(ORD_FIELD_COUNT);
+        if (file->units.empty() || (!f[0].empty() && f[0] != prev_ordref)) {
+            import_unit_t unit;
+            unit.first_row  = (int32_t)file->rows.size();
+            unit.row_count  = 0;
+            unit.ordref     = f[0];
+            unit.state      = state;
+            unit.failure    = 0;
+            unit.failed_row = 0;
+            file->units.push_back(unit);
+            if (!f[0].empty()) prev_ordref = f[0];
+        }
+        ord_valid_next(&state, f);
+        file->units.back().row_count++;
+        file->rows.push_back(std::string());
+        file->rows.back().swap(records[i]);
+    }
+}
+
+// Validate the orders of a shard against ORD as it was before the batch, and build them
+static void run_shard(const order_schema_t *schema, std::vector<import_file_t> &files,
+                      const std::vector<unit_ref_t> &units) {
+    std::vector<std::string> f;
+    std::vector<row_error_t> errors;
+
+    for (size_t u = 0; u < units.size(); u++) {
+        import_file_t &file = files[units[u].file];
+        import_unit_t &unit = file.units[units[u].unit];
+        ord_valid_state_t state = unit.state;
+
+        for (int32_t r = 0; r < unit.row_count; r++) {
+            split_fields(file.rows[unit.first_row + r], ',', f);
+            f.resize(ORD_FIELD_COUNT);
+            ord_valid_next(&state, f);
+
+            errors.clear();
+            if (!ord_valid_row(schema, f, &state, &schema->ord_ordref, errors)) {
+                for (size_t e = 0; e < errors.size(); e++) {
+                    unit_error_t error;
+                    error.row   = r;
+                    error.error = errors[e];
+                    unit.errors.push_back(error);
+                }
+            }
+            if (!unit.errors.empty() || unit.failure) {
+                continue;       // The file will not be inserted, or the order has already failed
+            }
+            if (r == 0) {
+                if (unit.ordref.empty()) {
+                    unit.failure = FAIL_NULL_ORDID;
+                    unit.failed_row = r;
+                    continue;
+                }
+                start_order(&unit.order, f);
+            }
+            if (!add_item(schema, &unit.order, f)) {
+                unit.failure = FAIL_PRECISION;
+                unit.failed_row = r;
+            }
+        }
+    }
+}
+
+static void read_worker(batch_t *batch) {
+    size_t i;
+    while ((i = batch->next++) < batch->files->size()) {
+        read_file(batch->schema, &(*batch->files)[i]);
+    }
+}
+
+static void shard_worker(batch_t *batch) {
+    size_t i;
+    while ((i = batch->next++) < batch->shards->size()) {
+        run_shard(batch->schema, *batch->files, (*batch->shards)[i]);
+    }
+}
+
+// Run worker on up to threads threads, the calling thread being one of them
+static void run_stage(void (*worker)(batch_t *), batch_t *batch, int threads, size_t tasks) {
+    std::vector<std::thread> started;
+    batch->next = 0;
+    for (int t = 1; t < threads && (size_t)t < tasks; t++) {
+        started.push_back(std::thread(worker, batch));
+    }
+    worker(batch);
+    for (size_t t = 0; t < started.size(); t++) {
+        started[t].join();
+    }
+}
+
+// Record a failed file's errors in IMPORTERROR in row order. An order with an ORDREF inserted by an earlier
+// file in the batch gets the duplicate error ORD_VALID would have raised, in its place among the row's errors.
+static void record_errors(order_schema_t *schema, const import_file_t &file,
+                          const std::unordered_set<std::string> &batch_ordrefs) {
+    std::vector<std::string> f;
+    std::vector<row_error_t> errors;
+
+    for (size_t u = 0; u < file.units.size(); u++) {
+        const import_unit_t &unit = file.units[u];
+        bool duplicate = batch_ordrefs.count(unit.ordref) != 0;
+        ord_valid_state_t state = unit.state;
+        size_t e = 0;
+
+        for (int32_t r = 0; r < unit.row_count && (duplicate || e < unit.errors.size()); r++) {
+            const std::string &rec = file.rows[unit.first_row + r];
+            errors.clear();
+            for (; e < unit.errors.size() && unit.errors[e].row == r; e++) {
+                errors.push_back(unit.errors[e].error);
+            }
+            if (duplicate) {
+                std::vector<row_error_t> checks;
+                split_fields(rec, ',', f);
+                f.resize(ORD_FIELD_COUNT);
+                ord_valid_next(&state, f);
+                ord_valid_row(schema, f, &state, &batch_ordrefs, checks);
+                for (size_t c = 0; c < checks.size(); c++) {
+                    if (checks[c].check == CHECK_DUPLICATE) {
+                        std::vector<row_error_t>::iterator it = errors.begin();
+                        while (it != errors.end() && it->check < CHECK_DUPLICATE) ++it;
+                        errors.insert(it, checks[c]);
+                    }
+                }
+            }
+            for (size_t i = 0; i < errors.size(); i++) {
+                import_error(schema, file.name, rec, errors[i].message, errors[i].key_value, NULL);
+            }
+        }
+    }
+}
+
+// Commit a file as ORD_IMP would finish it. Returns true if its orders were inserted.
+static bool commit_file(order_schema_t *schema, import_file_t *file, std::unordered_set<std::string> &batch_ordrefs) {
+    const char *filename = file->name.c_str();
+    if (file->read_result < 0) {
+        std::string message = "File not found " + make_path(schema->data_in, filename);
+        log_message(schema, message.c_str(), NULL, "UTIL_FILE.LOAD_CSV", 'E');
+        ord_imp_not_found(schema, filename);
+        return false;
+    }
+    schema->importcsv_fileid_seq++;
+
+    bool valid = true;
+    for (size_t u = 0; u < file->units.size() && valid; u++) {
+        valid = file->units[u].errors.empty() && !batch_ordrefs.count(file->units[u].ordref);
+    }
+    if (!valid) {
+        record_errors(schema, *file, batch_ordrefs);
+        ord_imp_invalid(schema, filename);
+        return false;
+    }
+
+    // ORDIDs are taken in row order, and are used up even if the file then fails
+    std::vector<int32_t> ordids(file->units.size(), 0);
+    for (size_t u = 0; u < file->units.size(); u++) {
+        const import_unit_t &unit = file->units[u];
+        if (!unit.ordref.empty()) {
+            ordids[u] = next_ordid(schema);
+            if (!ordids[u]) {
+                ord_imp_failed(schema, filename, file->rows[unit.first_row], FAIL_ORDID_EXCEEDED);
+                return false;
+            }
+        }
+        if (unit.failure) {
+            ord_imp_failed(schema, filename, file->rows[unit.first_row + unit.failed_row], unit.failure);
+            return false;
+        }
+    }
+
+    for (size_t u = 0; u < file->units.size(); u++) {
+        import_unit_t &unit = file->units[u];
+        insert_order(schema, &unit.order, ordids[u]);
+        batch_ordrefs.insert(unit.ordref);
+        delete_error(schema, unit.ordref);
+    }
+    rename_file(schema, schema->data_in, filename, schema->data_in_processed);
+    return true;
+}
+
+bool import_files(order_schema_t *schema, const std::vector<std::string> &filenames,
+                  const import_options_t *options, import_stats_t *stats) {
+    import_stats_t local_stats;
+    if (!stats) stats = &local_stats;
+    memset(stats, 0, sizeof(*stats));
+
+    int workers = options->workers > 0 ? options->workers : 1;
+    int shard_count = options->shards > 0 ? options->shards : workers;
+    std::vector<import_file_t> files(filenames.size());
+    std::vector<std::vector<unit_ref_t> > shards(shard_count);
+    batch_t batch;
+    batch.schema = schema;
+    batch.files  = &files;
+    batch.shards = &shards;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < filenames.size(); i++) {
+        files[i].name = filenames[i];
+    }
+    run_stage(read_worker, &batch, workers, files.size());
+    stats->read_us = elapsed_us(start);
+
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < files.size(); i++) {
+        for (size_t u = 0; u < files[i].units.size(); u++) {
+            unit_ref_t ref;
+            ref.file = (int32_t)i;
+            ref.unit = (int32_t)u;
+            shards[ordref_hash(files[i].units[u].ordref) % shard_count].push_back(ref);
+        }
+    }
+    run_stage(shard_worker, &batch, workers, shards.size());
+    stats->validate_us = elapsed_us(start);
+
+    start = std::chrono::steady_clock::now();
+    std::unordered_set<std::string> batch_ordrefs;
+    for (size_t i = 0; i < files.size(); i++) {
+        stats->rows += files[i].records;
+        if (commit_file(schema, &files[i], batch_ordrefs)) {
+            stats->files_ok++;
+        } else {
+            stats->files_failed++;
+        }
+        std::vector<std::string>().swap(files[i].rows);
+        std::vector<import_unit_t>().swap(files[i].units);
+    }
+    stats->commit_us = elapsed_us(start);
+    return stats->files_failed == 0;
+}
+
+bool import_order_files(order_schema_t *schema, const import_options_t *options, import_stats_t *stats) {
+    std::vector<std::string> filenames;
+    if (!list_order_files(schema, filenames)) {
+        printf("Error: Cannot read directory %s\n", schema->data_in.c_str());
+        if (stats) memset(stats, 0, sizeof(*stats));
+        return false;
+    }
+    return import_files(schema, filenames, options, stats);
+}
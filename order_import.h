@@ -0,0 +1,76 @@
+#ifndef ORDER_IMPORT_H
+#define ORDER_IMPORT_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "order_schema.h"
+
+/*
+  Program Name   : order_import.h
+  Description    : Concurrent sharded order import model for the order schema emulator
+  Copyright      : Bond & Pollard Ltd 2025
+  Auther         : agent
+  Date           : 18 October 2026
+
+
+  Imports a batch of ORDER*.csv files from DATA_IN into the order schema emulator
+  (order_schema.c) on several threads, with the same result as running ord_imp,
+  the emulator's IMPORT.ORD_IMP, on each file in turn in name order:
+  the same ORD and ITEM rows with the same ORDIDs, the same IMPORTERROR and
+  APPLOG rows, and the same files moved to DATA_IN\processed and DATA_IN\error.
+
+  1. Read: files are read and split into orders in parallel. As in ORD_IMP a row
+     with a new ORDREF starts an order, and a row with no ORDREF belongs to the
+     order before it.
+  2. Validate: orders are split into shards by a hash of ORDREF, so every row of an
+     order, and every order with the same ORDREF, is in one shard in file and row
+     order. Shards are run in parallel. Each row gets the ORD_VALID checks and each
+     order is built ready to insert.
+  3. Commit: files are committed one at a time in name order. An ORDREF inserted
+     by an earlier file in the batch is a duplicate, as ORD_VALID would find it
+     on ORD. A file with no errors has its orders inserted, taking ORDIDs in row
+     order, and is moved to processed. A file with errors has them written to
+     IMPORTERROR in row order and is moved to error. A file is committed whole
+     or not at all.
+
+  IMPORTCSV is not used, rows go straight from the file to the shards.
+
+  The Oracle import runs the same steps: import_order.bat stages each file with
+  IMPORT.ORD_STAGE, runs IMPORT.ORD_VALID_SHARD in one SQL*Plus session per
+  shard at the same time, then IMPORT.ORD_COMMIT on each file in the order they
+  were staged. This model does not connect to Oracle. ordbench -workers uses it
+  to measure how sharded validation scales, and order_import_test checks it
+  matches ord_imp.
+
+ */
+
+
+typedef struct {
+    int         workers;       // Threads for the read and validate stages
+    int         shards;        // Shards the orders are split into, 0 for one per worker
+} import_options_t;
+
+// Totals for a batch, times in microseconds
+typedef struct {
+    int64_t     files_ok;
+    int64_t     files_failed;
+    int64_t     rows;
+    int64_t     read_us;
+    int64_t     validate_us;
+    int64_t     commit_us;
+} import_stats_t;
+
+
+// ORDER*.CSV files in DATA_IN, in name order without regard to case
+bool list_order_files(order_schema_t *schema, std::vector<std::string> &filenames);
+
+// Import the files in DATA_IN in the order given. Returns false if any file was rejected.
+// stats may be NULL.
+bool import_files(order_schema_t *schema, const std::vector<std::string> &filenames,
+                  const import_options_t *options, import_stats_t *stats);
+
+// Import every ORDER*.CSV file in DATA_IN
+bool import_order_files(order_schema_t *schema, const import_options_t *options, import_stats_t *stats);
+
+#endif
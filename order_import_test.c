@@ -0,0 +1,299 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "order_schema.h"
+#include "order_import.h"
+
+/*
+  Program Name   : order_import_test.c
+  Description    : Tests for the concurrent sharded order import
+  Copyright      : Bond & Pollard Ltd 2025
+  Auther         : agent
+  Date           : 18 October 2026
+
+
+  Checks that import_order_files() in order_import.c gives the same result as
+  ord_imp() run on each file in turn, in the order import_order.bat finds them.
+
+  For each seed a batch of ORDER*.csv files is generated in DATA_IN under -dir with:
+    ORDREFs repeated within a file and across files
+    rows with no ORDREF, continuing the order before them or starting a file
+    ORDREFs too long for ORD.ORDREF
+    invalid order and ship dates, customers and products
+    quantities whose ITEMTOT overflows NUMBER(8,2)
+    blank lines and lines too long to read
+    lower case names such as order0003.CSV, so the name order must ignore case
+    an ORDID_MAX low enough that some batches run out of ORDIDs
+
+  The batch is imported with ord_imp(), then generated again and imported with
+  import_order_files() on 1, 2, 4, 8 and 32 workers. The exported orders, the
+  IMPORTERROR and APPLOG rows, the sequences and the directory each file was
+  moved to must be the same as for ord_imp(), or the program exits with status 1.
+
+  Usage: order_import_test [-seeds n] [-files n] [-dir path]
+
+  Build: g++ -O2 -o order_import_test.exe order_import_test.c order_schema.c order_import.c
+
+ */
+
+
+#define TEST_CUSTOMERS   50
+#define TEST_PRODUCTS    30
+
+static const int test_workers[] = { 1, 2, 4, 8, 32 };
+
+typedef struct {
+    int         seeds;
+    int         files;
+    const char *dir;
+} test_options_t;
+
+static unsigned int rng_state;
+
+static int random_below(int n) {
+    rng_state = rng_state * 1103515245U + 12345U;
+    return (int)((rng_state >> 8) % (unsigned int)n);
+}
+
+static std::string random_ordref() {
+    char ordref[16];
+    int pick = random_below(100);
+    if (pick < 3) return "";
+    if (pick < 5) return "TOOLONGREF12";
+    if (pick < 6) return "WAYTOOLONGORDERREFERENCEVALUE0123456789";
+    snprintf(ordref, sizeof(ordref), "R%d", random_below(400));
+    return ordref;
+}
+
+static void file_name(char *buffer, size_t size, int file_no) {
+    snprintf(buffer, size, file_no % 3 ? "ORDER%04d.csv" : "order%04d.CSV", file_no);
+}
+
+// Case insensitive name order, as import_order.bat lists the files
+static bool name_before(const std::string &a, const std::string &b) {
+    size_t i = 0;
+    while (i < a.size() && i < b.size() && toupper((unsigned char)a[i]) == toupper((unsigned char)b[i])) i++;
+    if (i == a.size() || i == b.size()) return a.size() < b.size();
+    return toupper((unsigned char)a[i]) < toupper((unsigned char)b[i]);
+}
+
+// Write the batch of order files for a seed into DATA_IN. The same seed always gives the same files.
+static bool generate_files(order_schema_t *schema, const test_options_t *options, unsigned int seed) {
+    char filename[32];
+    rng_state = seed;
+    schema->ordid_max = 622 + 20 + random_below(60);
+
+    for (int f = 1; f <= options->files; f++) {
+        file_name(filename, sizeof(filename), f);
+        std::string path = make_path(schema->data_in, filename);
+        FILE *file = fopen(path.c_str(), "w");
+        if (!file) {
+            printf("Error: Cannot open %s for writing!\n", path.c_str());
+            return false;
+        }
+        if (random_below(2)) {
+            fprintf(file, "\"Ord Ref\",\"Order Date\",\"Comm Plan\",\"Customer ID\",\"Ship Date\",\"Product ID\",\"Qty\"\n");
+        }
+        int orders = 1 + random_below(8);
+        bool invalid = random_below(100) < 25;
+        for (int o = 0; o < orders; o++) {
+            std::string ordref = random_ordref();
+            int items = 1 + random_below(4);
+            for (int i = 0; i < items; i++) {
+                std::string row_ordref = (i > 0 && random_below(3) == 0) ? std::string() : ordref;
+                int custid = 109 + random_below(TEST_CUSTOMERS);
+                int prodid = 200381 + random_below(TEST_PRODUCTS);
+                int qty = 1 + random_below(20);
+                char orderdate[16] = "01/02/2025", shipdate[16] = "03/02/2025";
+                if (invalid) {
+                    switch (random_below(12)) {
+                        case 0: strcpy(orderdate, "31/02/2025"); break;
+                        case 1: strcpy(shipdate, "01/01/2025"); break;     // Before the order date
+                        case 2: custid = 5; break;
+                        case 3: prodid = 1; break;
+                        case 4: strcpy(shipdate, "x"); break;
+                    }
+                }
+                if (random_below(60) == 0) qty = 90000;                   // ITEMTOT too large
+                if (random_below(40) == 0) shipdate[0] = '\0';
+                fprintf(file, "%s,%s,\"A\",%d,%s,%d,%d\n", row_ordref.c_str(), orderdate, custid, shipdate, prodid, qty);
+                if (random_below(50) == 0) fprintf(file, "\n");
+            }
+        }
+        if (random_below(40) == 0) {
+            fprintf(file, "%s\n", std::string(4100, 'x').c_str());
+        }
+        fclose(file);
+    }
+    return true;
+}
+
+// A seeded schema with the batch for the seed in DATA_IN, or NULL on error
+static order_schema_t *prepare_run(const test_options_t *options, unsigned int seed) {
+    static const int32_t empno[] = { 7499, 7521, 7654, 7698, 7844 };
+    char filename[32];
+    order_schema_t *schema = new order_schema_t();
+    schema_init(schema, options->dir);
+    schema->sysdate = 20260101;
+    if (!schema_create_directories(schema)) {
+        printf("Error: Could not create the data directories under %s\n", options->dir);
+        delete schema;
+        return NULL;
+    }
+    for (int f = 1; f <= options->files; f++) {
+        file_name(filename, sizeof(filename), f);
+        remove(make_path(schema->data_in, filename).c_str());
+        remove(make_path(schema->data_in_processed, filename).c_str());
+        remove(make_path(schema->data_in_error, filename).c_str());
+    }
+    for (int i = 0; i < 5; i++) {
+        insert_emp(schema, empno[i], "EMP");
+    }
+    for (int i = 0; i < TEST_CUSTOMERS; i++) {
+        insert_customer(schema, 0, "CUSTOMER", empno[i % 5]);
+    }
+    for (int i = 0; i < TEST_PRODUCTS; i++) {
+        int32_t prodid = insert_product(schema, 0, "PRODUCT");
+        insert_price(schema, prodid, 100 + i * 1000, 50, 20000101, 0);
+    }
+    if (!generate_files(schema, options, seed)) {
+        delete schema;
+        return NULL;
+    }
+    return schema;
+}
+
+static bool file_exists(const std::string &path) {
+    FILE *file = fopen(path.c_str(), "rb");
+    if (file) fclose(file);
+    return file != NULL;
+}
+
+// Everything the import changed, as text to compare: the exported orders, IMPORTERROR and
+// APPLOG rows (without their times), the sequences and where each file ended up
+static std::string import_result(order_schema_t *schema, const test_options_t *options) {
+    std::string result;
+    char line[256], filename[32];
+
+    export_orders(schema, "order_import_test.csv");
+    FILE *file = fopen(make_path(schema->data_out, "order_import_test.csv").c_str(), "r");
+    while (file && fgets(line, sizeof(line), file)) {
+        result += line;
+    }
+    if (file) fclose(file);
+
+    for (size_t i = 0; i < schema->importerror.size(); i++) {
+        const importerror_t &error = schema->importerror[i];
+        snprintf(line, sizeof(line), "IMPORTERROR %lld %d|", (long long)error.recid, error.deleted ? 1 : 0);
+        result += line + error.filename + "|" + error.error_data + "|" + error.error_message + "|"
+                + error.key_value + "|" + error.import_sqlerrm + "\n";
+    }
+    for (size_t i = 0; i < schema->applog.size(); i++) {
+        const applog_t &log = schema->applog[i];
+        result += "APPLOG " + log.program_name + " " + log.severity + "|" + log.message + "|" + log.applog_sqlerrm + "\n";
+    }
+    snprintf(line, sizeof(line), "ORDID_SEQ %lld IMPORTCSV_FILEID_SEQ %lld\n", (long long)schema->ordid_seq,
+             (long long)schema->importcsv_fileid_seq);
+    result += line;
+    for (int f = 1; f <= options->files; f++) {
+        file_name(filename, sizeof(filename), f);
+        result += filename;
+        result += file_exists(make_path(schema->data_in_processed, filename)) ? " processed\n"
+                : file_exists(make_path(schema->data_in_error, filename)) ? " error\n"
+                : file_exists(make_path(schema->data_in, filename)) ? " DATA_IN\n" : " missing\n";
+    }
+    return result;
+}
+
+// Import the batch with ord_imp() one file at a time if workers is 0, else with import_order_files()
+static bool run_import(const test_options_t *options, unsigned int seed, int workers, std::string &result) {
+    char filename[32];
+    order_schema_t *schema = prepare_run(options, seed);
+    if (!schema) {
+        return false;
+    }
+    if (workers == 0) {
+        std::vector<std::string> names;
+        for (int f = 1; f <= options->files; f++) {
+            file_name(filename, sizeof(filename), f);
+            names.push_back(filename);
+        }
+        std::sort(names.begin(), names.end(), name_before);
+        for (size_t i = 0; i < names.size(); i++) {
+            ord_imp(schema, names[i].c_str(), NULL);
+        }
+    } else {
+        import_options_t import_options;
+        import_options.workers = workers;
+        import_options.shards  = 0;
+        import_order_files(schema, &import_options, NULL);
+    }
+    result = import_result(schema, options);
+    delete schema;
+    return true;
+}
+
+// Print the first line where the results differ
+static void print_difference(const std::string &expected, const std::string &actual) {
+    size_t line_start = 0, i = 0;
+    while (i < expected.size() && i < actual.size() && expected[i] == actual[i]) {
+        if (expected[i] == '\n') line_start = i + 1;
+        i++;
+    }
+    size_t expected_end = expected.find('\n', line_start), actual_end = actual.find('\n', line_start);
+    printf("  ord_imp : %s\n", expected.substr(line_start, expected_end - line_start).c_str());
+    printf("  sharded : %s\n", actual.substr(line_start, actual_end - line_start).c_str());
+}
+
+static void usage() {
+    printf("Usage: order_import_test [-seeds n] [-files n] [-dir path]\n");
+}
+
+int main(int argc, char *argv[]) {
+    test_options_t options;
+    options.seeds = 50;
+    options.files = 20;
+    options.dir   = "order_import_test";
+
+    for (int i = 1; i < argc; i += 2) {
+        if (i + 1 >= argc) {
+            usage();
+            return -1;
+        }
+        if (strcmp(argv[i], "-seeds") == 0)      options.seeds = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-files") == 0) options.files = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "-dir") == 0)   options.dir = argv[i + 1];
+        else {
+            usage();
+            return -1;
+        }
+    }
+    if (options.seeds < 1 || options.files < 1 || options.files > 9999) {
+        usage();
+        return -1;
+    }
+
+    int failures = 0;
+    for (int seed = 1; seed <= options.seeds; seed++) {
+        std::string expected, actual;
+        if (!run_import(&options, (unsigned int)seed, 0, expected)) {
+            return -1;
+        }
+        for (size_t w = 0; w < sizeof(test_workers) / sizeof(test_workers[0]); w++) {
+            if (!run_import(&options, (unsigned int)seed, test_workers[w], actual)) {
+                return -1;
+            }
+            if (actual != expected) {
+                printf("FAIL seed %d, %d worker(s): result differs from ord_imp\n", seed, test_workers[w]);
+                print_difference(expected, actual);
+                failures++;
+            }
+        }
+    }
+    printf("%d seed(s) of %d files, %d run(s) differed from ord_imp.\n", options.seeds, options.files, failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,768 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <sys/stat.h>
+#include <chrono>
+#ifdef _WIN32
+#include <direct.h>       // For _mkdir()
+#endif
+#include "order_schema.h"
+
+/*
+  Program Name   : order_schema.c
+  Description    : In memory emulator of the sales order schema
+  Copyright      : Bond & Pollard Ltd 2025
+  Auther         : agent
+  Date           : 18 October 2026
+
+
+  Implements the order schema emulator described in order_schema.h.
+  The comments name the PL/SQL each function stands in for, see
+  IMPORT.sql, EXPORT.sql, UTIL_FILE.sql, UTIL_STRING.sql and ORDERRP.sql.
+
+ */
+
+
+#ifdef _WIN32
+#define DIR_DELIMITER "\\"
+#else
+#define DIR_DELIMITER "/"
+#endif
+
+#define CSV_REC_LENGTH   4000    // IMPORTCSV.CSV_REC VARCHAR2(4000)
+
+static const char *ora_value_error  = "ORA-06502: PL/SQL: numeric or value error";
+static const char *ora_precision    = "ORA-06502: PL/SQL: numeric or value error: number precision too large";
+static const char *ora_null_ordid   = "ORA-01400: cannot insert NULL into (\"ITEM\".\"ORDID\")";
+
+
+std::string make_path(const std::string &directory, const char *filename) {
+    return directory + DIR_DELIMITER + filename;
+}
+
+static bool make_directory(const std::string &path) {
+    struct stat info;
+    if (stat(path.c_str(), &info) == 0) {
+        return (info.st_mode & S_IFDIR) != 0;
+    }
+#ifdef _WIN32
+    return _mkdir(path.c_str()) == 0;
+#else
+    return mkdir(path.c_str(), 0755) == 0;
+#endif
+}
+
+static bool file_exists(const std::string &path) {
+    struct stat info;
+    return stat(path.c_str(), &info) == 0 && !(info.st_mode & S_IFDIR);
+}
+
+static int32_t today() {
+    time_t now = time(NULL);
+    struct tm *local = localtime(&now);
+    return (local->tm_year + 1900) * 10000 + (local->tm_mon + 1) * 100 + local->tm_mday;
+}
+
+void schema_init(order_schema_t *schema, const char *data_home) {
+    schema->data_home         = data_home;
+    schema->data_in           = schema->data_home + DIR_DELIMITER + "DATA_IN";
+    schema->data_in_error     = schema->data_in + DIR_DELIMITER + "error";
+    schema->data_in_processed = schema->data_in + DIR_DELIMITER + "processed";
+    schema->data_out          = schema->data_home + DIR_DELIMITER + "DATA_OUT";
+
+    // Starting values from install_schema.sql
+    schema->custid_seq           = 109;
+    schema->ordid_seq            = 622;
+    schema->prodid_seq           = 200381;
+    schema->importcsv_fileid_seq = 1;
+    schema->importcsv_recid      = 1;
+    schema->importerror_recid    = 1;
+    schema->applog_recid         = 1;
+
+    schema->sysdate   = today();
+    schema->ordid_max = ORDID_MAX;
+
+    const char *user = getenv("USERNAME");
+    if (!user) user = getenv("USER");
+    schema->user_name = user ? user : "UNKNOWN";
+    for (size_t i = 0; i < schema->user_name.size(); i++) {
+        schema->user_name[i] = (char)toupper((unsigned char)schema->user_name[i]);
+    }
+}
+
+bool schema_create_directories(order_schema_t *schema) {
+    return make_directory(schema->data_home) && make_directory(schema->data_in) && make_directory(schema->data_in_error)
+        && make_directory(schema->data_in_processed) && make_directory(schema->data_out);
+}
+
+int32_t insert_customer(order_schema_t *schema, int32_t custid, const char *name, int32_t repid) {
+    customer_t customer;
+    customer.custid = custid ? custid : (int32_t)schema->custid_seq++;   // Trigger INSERT_CUSTOMER
+    customer.name   = name;
+    customer.repid  = repid;
+    schema->customer_idx[customer.custid] = schema->customer.size();
+    schema->customer.push_back(customer);
+    return customer.custid;
+}
+
+void insert_emp(order_schema_t *schema, int32_t empno, const char *ename) {
+    emp_t emp;
+    emp.empno = empno;
+    emp.ename = ename;
+    schema->emp_idx[empno] = schema->emp.size();
+    schema->emp.push_back(emp);
+}
+
+int32_t insert_product(order_schema_t *schema, int32_t prodid, const char *descrip) {
+    product_t product;
+    product.prodid  = prodid ? prodid : (int32_t)schema->prodid_seq++;   // Trigger INSERT_PRODUCT
+    product.descrip = descrip;
+    schema->product_idx[product.prodid] = schema->product.size();
+    schema->product.push_back(product);
+    return product.prodid;
+}
+
+void insert_price(order_schema_t *schema, int32_t prodid, int64_t stdprice, int64_t minprice,
+                  int32_t startdate, int32_t enddate) {
+    price_t price;
+    price.prodid    = prodid;
+    price.stdprice  = stdprice;
+    price.minprice  = minprice;
+    price.startdate = startdate;
+    price.enddate   = enddate;
+    schema->price_idx[prodid].push_back(schema->price.size());
+    schema->price.push_back(price);
+}
+
+void log_message(order_schema_t *schema, const char *message, const char *sqlerrm,
+                 const char *program_name, char severity) {
+    applog_t log;
+    log.recid          = schema->applog_recid++;
+    log.message        = message;
+    log.logged_at      = time(NULL);
+    log.user_name      = schema->user_name;
+    log.applog_sqlerrm = sqlerrm ? sqlerrm : "";
+    log.program_name   = program_name;
+    log.severity       = severity;
+    schema->applog.push_back(log);
+}
+
+// ORDERRP.CURRENTPRICE: highest STDPRICE in effect today, or 0.
+// SYSDATE includes the time of day, so a price ending today is no longer current.
+int64_t currentprice(const order_schema_t *schema, int32_t prodid) {
+    int64_t result = -1;
+    std::unordered_map<int32_t, std::vector<size_t> >::const_iterator it = schema->price_idx.find(prodid);
+    if (it == schema->price_idx.end()) {
+        return 0;
+    }
+    for (size_t i = 0; i < it->second.size(); i++) {
+        const price_t &price = schema->price[it->second[i]];
+        if (price.startdate <= schema->sysdate && (price.enddate == 0 || price.enddate > schema->sysdate)
+            && price.stdprice > result) {
+            result = price.stdprice;
+        }
+    }
+    return result < 0 ? 0 : result;
+}
+
+// Split a record into fields as UTIL_STRING.GET_FIELD does: delimiters inside double
+// quotes are ignored, fields are trimmed of spaces and enclosing quotes are removed.
+void split_fields(const std::string &rec, char delimiter, std::vector<std::string> &fields) {
+    size_t start = 0;
+    bool quotes_open = false;
+    fields.clear();
+    for (size_t i = 0; i <= rec.size(); i++) {
+        if (i < rec.size() && rec[i] == '"') {
+            quotes_open = !quotes_open;
+        }
+        if (i == rec.size() || (rec[i] == delimiter && !quotes_open)) {
+            size_t first = start, last = i;
+            while (first < last && rec[first] == ' ') first++;
+            while (last > first && rec[last - 1] == ' ') last--;
+            if (last - first >= 2 && rec[first] == '"' && rec[last - 1] == '"') {
+                first++;
+                last--;
+            }
+            fields.push_back(rec.substr(first, last - first));
+            start = i + 1;
+        }
+    }
+}
+
+std::string get_field(const std::string &rec, int position, char delimiter) {
+    std::vector<std::string> fields;
+    split_fields(rec, delimiter, fields);
+    return position >= 1 && position <= (int)fields.size() ? fields[position - 1] : std::string();
+}
+
+bool parse_date(const std::string &text, int32_t *date) {
+    static const int days_in_month[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    int part[3] = { 0, 0, 0 };
+    int digits = 0, index = 0;
+
+    for (size_t i = 0; i < text.size(); i++) {
+        if (isdigit((unsigned char)text[i])) {
+            part[index] = part[index] * 10 + (text[i] - '0');
+            if (++digits > (index == 2 ? 4 : 2)) return false;
+        } else if (text[i] == '/' && index < 2 && digits > 0) {
+            index++;
+            digits = 0;
+        } else {
+            return false;
+        }
+    }
+    if (index != 2 || digits == 0) {
+        return false;
+    }
+    int day = part[0], month = part[1], year = part[2];
+    if (year < 1 || month < 1 || month > 12 || day < 1) {
+        return false;
+    }
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    if (day > days_in_month[month - 1] + (month == 2 && leap ? 1 : 0)) {
+        return false;
+    }
+    *date = year * 10000 + month * 100 + day;
+    return true;
+}
+
+// TO_NUMBER for [+-]digits[.digits], returns false if the text is not a number.
+// Exponents, hex, inf, nan and surrounding spaces are rejected.
+static bool parse_number(const std::string &text, double *value) {
+    size_t i = 0;
+    if (i < text.size() && (text[i] == '+' || text[i] == '-')) {
+        i++;
+    }
+    size_t digits = i;
+    while (i < text.size() && isdigit((unsigned char)text[i])) {
+        i++;
+    }
+    if (i == digits) {
+        return false;
+    }
+    if (i < text.size() && text[i] == '.') {
+        size_t fraction = ++i;
+        while (i < text.size() && isdigit((unsigned char)text[i])) {
+            i++;
+        }
+        if (i == fraction) {
+            return false;
+        }
+    }
+    if (i != text.size()) {
+        return false;
+    }
+    *value = strtod(text.c_str(), NULL);
+    return true;
+}
+
+// Numeric key lookup in SQL, WHERE custid = '<field>'. Returns 1 found, 0 not found, -1 invalid number.
+static int find_number_key(const std::unordered_map<int32_t, size_t> &index, const std::string &text) {
+    double value;
+    if (text.empty()) {
+        return 0;
+    }
+    if (!parse_number(text, &value)) {
+        return -1;
+    }
+    if (value != floor(value) || fabs(value) > 2147483647.0) {
+        return 0;
+    }
+    return index.count((int32_t)value) ? 1 : 0;
+}
+
+// Value of a field that has passed validation as a whole number
+static int32_t number_value(const std::string &text) {
+    double value;
+    return parse_number(text, &value) ? (int32_t)value : 0;
+}
+
+static std::string format_date(int32_t date) {
+    char buffer[16];
+    if (date == 0) {
+        return std::string();
+    }
+    snprintf(buffer, sizeof(buffer), "%02d/%02d/%04d", date % 100, (date / 100) % 100, date / 10000);
+    return buffer;
+}
+
+// LTRIM(TO_CHAR(n, '99999999.99')), no leading zero before the decimal point
+static std::string format_money(int64_t pence) {
+    char buffer[32];
+    const char *sign = pence < 0 ? "-" : "";
+    int64_t value = pence < 0 ? -pence : pence;
+    if (value < 100) {
+        snprintf(buffer, sizeof(buffer), "%s.%02lld", sign, (long long)value);
+    } else {
+        snprintf(buffer, sizeof(buffer), "%s%lld.%02lld", sign, (long long)(value / 100), (long long)(value % 100));
+    }
+    return buffer;
+}
+
+// IMPORT.IMPORT_ERROR
+void import_error(order_schema_t *schema, const std::string &filename, const std::string &rec,
+                  const std::string &message, const std::string &key_value, const char *sqlerrm) {
+    if (key_value.size() > KEY_VALUE_LENGTH) {
+        // IMPORTERROR.KEY_VALUE is VARCHAR2(30), the insert fails and is logged instead
+        log_message(schema, "Error inserting row into IMPORTERROR", ora_value_error, "IMPORT.IMPORT_ERROR", 'E');
+        return;
+    }
+    importerror_t error;
+    error.recid          = schema->importerror_recid++;
+    error.filename       = filename;
+    error.error_data     = rec;
+    error.error_message  = message;
+    error.error_time     = time(NULL);
+    error.user_name      = schema->user_name;
+    error.key_value      = key_value;
+    error.import_sqlerrm = sqlerrm ? sqlerrm : "";
+    error.deleted        = false;
+    if (!key_value.empty()) {
+        schema->importerror_key.insert(std::make_pair(key_value, schema->importerror.size()));
+    }
+    schema->importerror.push_back(error);
+}
+
+int64_t importerror_count(order_schema_t *schema) {
+    int64_t count = 0;
+    for (size_t i = 0; i < schema->importerror.size(); i++) {
+        if (!schema->importerror[i].deleted) count++;
+    }
+    return count;
+}
+
+void delete_error(order_schema_t *schema, const std::string &key_value) {
+    if (key_value.empty()) {
+        return;
+    }
+    std::pair<std::unordered_multimap<std::string, size_t>::iterator,
+              std::unordered_multimap<std::string, size_t>::iterator> range = schema->importerror_key.equal_range(key_value);
+    for (std::unordered_multimap<std::string, size_t>::iterator it = range.first; it != range.second; ++it) {
+        schema->importerror[it->second].deleted = true;
+    }
+    schema->importerror_key.erase(key_value);
+}
+
+// IMPORT.DELETE_ERROR: delete old errors for the orders in the file
+static void delete_file_errors(order_schema_t *schema, size_t first_row) {
+    for (size_t i = first_row; i < schema->importcsv.size(); i++) {
+        delete_error(schema, schema->importcsv[i].key_value);
+    }
+}
+
+// UTIL_FILE.RENAME_FILE, errors are logged not raised
+void rename_file(order_schema_t *schema, const std::string &src_location, const char *filename,
+                 const std::string &dest_location) {
+    std::string source = make_path(src_location, filename);
+    std::string destination = make_path(dest_location, filename);
+    if (file_exists(destination) || rename(source.c_str(), destination.c_str()) != 0) {
+        std::string message = "Error renaming from " + source + " to " + destination;
+        log_message(schema, message.c_str(), "ORA-29292: file rename operation failed", "UTIL_FILE.RENAME_FILE", 'E');
+    }
+}
+
+int read_csv(const std::string &path, std::vector<std::string> &records) {
+    FILE *file = fopen(path.c_str(), "r");
+    if (!file) {
+        return -1;
+    }
+    char line[CSV_REC_LENGTH + 4];
+    while (fgets(line, sizeof(line), file)) {
+        size_t len = strcspn(line, "\r\n");
+        if (len > CSV_REC_LENGTH) {
+            fclose(file);
+            return 0;
+        }
+        records.push_back(std::string(line, len));
+    }
+    fclose(file);
+    return 1;
+}
+
+// UTIL_FILE.LOAD_CSV: load the file into IMPORTCSV. Returns the FILEID, -1 if the file
+// was not found, or 0 if a record could not be loaded.
+static int64_t load_csv(order_schema_t *schema, const char *filename) {
+    std::string path = make_path(schema->data_in, filename);
+    std::vector<std::string> records;
+    int result = read_csv(path, records);
+    if (result < 0) {
+        std::string message = "File not found " + path;
+        log_message(schema, message.c_str(), NULL, "UTIL_FILE.LOAD_CSV", 'E');
+        return -1;
+    }
+
+    int64_t fileid = schema->importcsv_fileid_seq++;
+    for (size_t i = 0; i < records.size(); i++) {
+        importcsv_t rec;
+        rec.recid    = schema->importcsv_recid++;
+        rec.fileid   = fileid;
+        rec.filename = filename;
+        rec.csv_rec.swap(records[i]);
+        schema->importcsv.push_back(rec);
+    }
+    return result ? fileid : 0;
+}
+
+bool is_order_record(const std::string &csv_rec) {
+    return !csv_rec.empty() && csv_rec.compare(0, 9, "\"Ord Ref\"") != 0;
+}
+
+void ord_valid_next(ord_valid_state_t *state, const std::vector<std::string> &fields) {
+    if (fields[0].size() <= KEY_VALUE_LENGTH) {
+        state->key_value = fields[0];
+    }
+    if (fields[1].empty()) {
+        state->orderdate = 0;
+    } else {
+        parse_date(fields[1], &state->orderdate);
+    }
+    if (fields[4].empty()) {
+        state->shipdate = 0;
+    } else {
+        parse_date(fields[4], &state->shipdate);
+    }
+}
+
+static void row_error(std::vector<row_error_t> &errors, int check, const std::string &message,
+                      const std::string &key_value) {
+    row_error_t error;
+    error.check     = check;
+    error.message   = message;
+    error.key_value = key_value;
+    errors.push_back(error);
+}
+
+bool ord_valid_row(const order_schema_t *schema, const std::vector<std::string> &f,
+                   const ord_valid_state_t *state, const std::unordered_set<std::string> *ordrefs,
+                   std::vector<row_error_t> &errors) {
+    size_t first_error = errors.size();
+    const std::string &ordref = f[0];
+    const std::string &key_value = state->key_value;
+    int32_t date;
+
+    if (ordref.size() > KEY_VALUE_LENGTH) {
+        row_error(errors, CHECK_KEY_VALUE, "IMPORTCSV.KEY_VALUE " + ordref + " too long.", ordref);
+    }
+
+    if (ordref.size() > ORDREF_LENGTH) {
+        row_error(errors, CHECK_ORDREF, "OrdRef " + ordref + " invalid. Must not be longer than 10 characters", key_value);
+    }
+
+    if (ordrefs && ordrefs->count(ordref)) {
+        row_error(errors, CHECK_DUPLICATE, "OrdRef " + ordref + " already exists on ORD, duplicate value", key_value);
+    }
+
+    if (!f[1].empty() && !parse_date(f[1], &date)) {
+        row_error(errors, CHECK_ORDER_DATE, "Order Date " + f[1] + " invalid, format must be DD/MM/YYYY", key_value);
+    }
+
+    if (f[2].size() > 1) {
+        row_error(errors, CHECK_COMMPLAN, "CommPlan " + f[2] + " invalid. Must be a single character", key_value);
+    }
+
+    int found = find_number_key(schema->customer_idx, f[3]);
+    if (found == 0) {
+        row_error(errors, CHECK_CUSTOMER, "Customer ID " + f[3] + " not found on Customer", key_value);
+    } else if (found < 0) {
+        row_error(errors, CHECK_CUSTOMER, "Customer ID " + f[3] + " invalid", key_value);
+    }
+
+    if (!f[4].empty() && !parse_date(f[4], &date)) {
+        row_error(errors, CHECK_SHIP_DATE, "Ship Date " + f[4] + " invalid, format must be DD/MM/YYYY", key_value);
+    }
+
+    if (state->shipdate != 0 && state->orderdate != 0 && state->shipdate < state->orderdate) {
+        row_error(errors, CHECK_SHIP_AFTER_ORDER, "Ship Date " + f[4] + " must be on or later than the order date "
+                  + format_date(state->orderdate), key_value);
+    }
+
+    found = find_number_key(schema->product_idx, f[5]);
+    if (found == 0) {
+        row_error(errors, CHECK_PRODUCT, "Product ID " + f[5] + " not found on Product", key_value);
+    } else if (found < 0) {
+        row_error(errors, CHECK_PRODUCT, "Product ID " + f[5] + " invalid", key_value);
+    }
+
+    // A failed TO_NUMBER in PL/SQL raises VALUE_ERROR, not INVALID_NUMBER,
+    // so ORD_VALID reports it through its WHEN OTHERS handler.
+    double qty;
+    if (!f[6].empty() && (!parse_number(f[6], &qty) || fabs(qty) >= QTY_MAX + 0.5)) {
+        row_error(errors, CHECK_QTY, "Qty " + f[6] + " invalid", key_value);
+    }
+    return errors.size() == first_error;
+}
+
+// IMPORT.ORD_VALID: validate every row of the file, recording errors in IMPORTERROR
+static bool ord_valid(order_schema_t *schema, size_t first_row) {
+    bool valid = true;
+    std::vector<std::string> f;
+    std::vector<row_error_t> errors;
+    ord_valid_state_t state;
+    state.orderdate = 0;
+    state.shipdate  = 0;
+
+    for (size_t i = first_row; i < schema->importcsv.size(); i++) {
+        importcsv_t &rec = schema->importcsv[i];
+        if (!is_order_record(rec.csv_rec)) {
+            continue;
+        }
+        split_fields(rec.csv_rec, ',', f);
+        f.resize(ORD_FIELD_COUNT);
+        ord_valid_next(&state, f);
+        if (f[0].size() <= KEY_VALUE_LENGTH) {
+            rec.key_value = state.key_value;
+        }
+
+        errors.clear();
+        if (!ord_valid_row(schema, f, &state, &schema->ord_ordref, errors)) {
+            valid = false;
+            for (size_t e = 0; e < errors.size(); e++) {
+                import_error(schema, rec.filename, rec.csv_rec, errors[e].message, errors[e].key_value, NULL);
+            }
+        }
+    }
+    return valid;
+}
+
+void start_order(ord_t *order, const std::vector<std::string> &f) {
+    order->ordid    = 0;
+    order->ordref   = f[0];
+    order->commplan = f[2];
+    order->custid   = number_value(f[3]);
+    order->total    = 0;
+    order->items.clear();
+    if (f[1].empty() || !parse_date(f[1], &order->orderdate)) order->orderdate = 0;
+    if (f[4].empty() || !parse_date(f[4], &order->shipdate)) order->shipdate = 0;
+}
+
+bool add_item(const order_schema_t *schema, ord_t *order, const std::vector<std::string> &f) {
+    item_t item;
+    double qty = 0;
+    item.ordid       = order->ordid;
+    item.itemid      = (int32_t)order->items.size() + 1;
+    item.prodid      = number_value(f[5]);
+    item.actualprice = currentprice(schema, item.prodid);
+    item.qty         = parse_number(f[6], &qty) ? (int64_t)llround(qty) : 0;
+    item.itemtot     = item.actualprice * item.qty;
+    if (llabs(item.itemtot) > MONEY_MAX || llabs(order->total + item.itemtot) > MONEY_MAX) {
+        return false;
+    }
+    order->items.push_back(item);
+    order->total += item.itemtot;
+    return true;
+}
+
+int32_t next_ordid(order_schema_t *schema) {
+    int64_t ordid = schema->ordid_seq++;
+    return ordid > schema->ordid_max ? 0 : (int32_t)ordid;
+}
+
+void insert_order(order_schema_t *schema, ord_t *order, int32_t ordid) {
+    ord_t &row = schema->ord[ordid];
+    row.ordid     = ordid;
+    row.orderdate = order->orderdate;
+    row.ordref.swap(order->ordref);
+    row.commplan.swap(order->commplan);
+    row.custid    = order->custid;
+    row.shipdate  = order->shipdate;
+    row.total     = order->total;
+    row.items.swap(order->items);
+    for (size_t i = 0; i < row.items.size(); i++) {
+        row.items[i].ordid = ordid;
+    }
+    schema->ord_ordref.insert(row.ordref);
+}
+
+// Undo the ORD and ITEM rows inserted for a file, ROLLBACK TO before_load_csv
+static void rollback_orders(order_schema_t *schema, const std::vector<int32_t> &inserted) {
+    for (size_t i = 0; i < inserted.size(); i++) {
+        std::map<int32_t, ord_t>::iterator it = schema->ord.find(inserted[i]);
+        if (it != schema->ord.end()) {
+            schema->ord_ordref.erase(it->second.ordref);
+            schema->ord.erase(it);
+        }
+    }
+}
+
+void ord_imp_not_found(order_schema_t *schema, const char *filename) {
+    import_error(schema, filename, "", "IMPORT.ORD_IMP File not found. Order import failed.", "", NULL);
+    log_message(schema, (std::string("File not found importing file ") + filename).c_str(), NULL, "IMPORT.ORD_IMP", 'E');
+}
+
+void ord_imp_invalid(order_schema_t *schema, const char *filename) {
+    log_message(schema, (std::string("Invalid data importing file ") + filename).c_str(), NULL, "IMPORT.ORD_IMP", 'E');
+    rename_file(schema, schema->data_in, filename, schema->data_in_error);
+}
+
+void ord_imp_failed(order_schema_t *schema, const char *filename, const std::string &current_rec, int reason) {
+    const char *failure = reason == FAIL_PRECISION ? ora_precision : reason == FAIL_NULL_ORDID ? ora_null_ordid : ora_value_error;
+    if (reason == FAIL_ORDID_EXCEEDED) {
+        import_error(schema, filename, current_rec, "IMPORT.ORD_IMP ORDID maximum value exceeded. Next ORDID is ", "", failure);
+        log_message(schema, (std::string("Maximum ORDID value exceeded importing file ") + filename).c_str(), failure,
+                    "IMPORT.ORD_IMP", 'E');
+    } else {
+        import_error(schema, filename, current_rec, "IMPORT.ORD_IMP Unexpected error. Order import failed.", "", failure);
+        log_message(schema, (std::string("Unexpected error importing file ") + filename).c_str(), failure,
+                    "IMPORT.ORD_IMP", 'E');
+    }
+    rename_file(schema, schema->data_in, filename, schema->data_in_error);
+}
+
+static int64_t elapsed_us(std::chrono::steady_clock::time_point start) {
+    return (int64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool ord_imp(order_schema_t *schema, const char *filename, ord_imp_stats_t *stats) {
+    ord_imp_stats_t local_stats;
+    if (!stats) stats = &local_stats;
+    memset(stats, 0, sizeof(*stats));
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    size_t first_row = schema->importcsv.size();
+    int64_t fileid = load_csv(schema, filename);
+    stats->load_us = elapsed_us(start);
+    stats->rows = (int64_t)(schema->importcsv.size() - first_row);
+
+    if (fileid == -1) {
+        ord_imp_not_found(schema, filename);
+        return false;
+    }
+    if (fileid == 0) {
+        // LOAD_CSV failed part way, ORD_IMP goes on to process FILEID 0 which has no rows
+        first_row = schema->importcsv.size();
+    }
+
+    start = std::chrono::steady_clock::now();
+    if (!ord_valid(schema, first_row)) {
+        stats->validate_us = elapsed_us(start);
+        schema->importcsv.resize(first_row);     // UTIL_FILE.DELETE_CSV
+        ord_imp_invalid(schema, filename);
+        return false;
+    }
+    stats->validate_us = elapsed_us(start);
+
+    start = std::chrono::steady_clock::now();
+    std::vector<int32_t> inserted;
+    std::vector<std::string> f;
+    std::string prev_ordref = " ";
+    std::string current_rec;
+    ord_t order;
+    int32_t ordid = 0;
+    int failure = 0;
+
+    for (size_t i = first_row; i < schema->importcsv.size(); i++) {
+        const importcsv_t &rec = schema->importcsv[i];
+        if (!is_order_record(rec.csv_rec)) {
+            continue;
+        }
+        current_rec = rec.csv_rec;
+        split_fields(rec.csv_rec, ',', f);
+        f.resize(ORD_FIELD_COUNT);
+
+        // A NULL ORDREF never compares unequal, so the row is added to the current order
+        if (!f[0].empty() && f[0] != prev_ordref) {
+            if (ordid) {
+                insert_order(schema, &order, ordid);
+                inserted.push_back(ordid);
+            }
+            ordid = next_ordid(schema);
+            if (!ordid) {
+                failure = FAIL_ORDID_EXCEEDED;
+                break;
+            }
+            start_order(&order, f);
+            prev_ordref = f[0];
+        }
+        if (!ordid) {
+            failure = FAIL_NULL_ORDID;
+            break;
+        }
+        if (!add_item(schema, &order, f)) {
+            failure = FAIL_PRECISION;
+            break;
+        }
+    }
+    if (!failure && ordid) {
+        insert_order(schema, &order, ordid);
+    }
+    stats->insert_us = elapsed_us(start);
+
+    if (failure) {
+        rollback_orders(schema, inserted);
+        schema->importcsv.resize(first_row);
+        ord_imp_failed(schema, filename, current_rec, failure);
+        return false;
+    }
+
+    delete_file_errors(schema, first_row);
+    schema->importcsv.resize(first_row);         // UTIL_FILE.DELETE_CSV
+    rename_file(schema, schema->data_in, filename, schema->data_in_processed);
+    return true;
+}
+
+int64_t export_orders(order_schema_t *schema, const char *filename) {
+    char default_name[32];
+    if (!filename) {
+        // orders_YYMMDD.csv
+        snprintf(default_name, sizeof(default_name), "orders_%06d.csv", schema->sysdate % 1000000);
+        filename = default_name;
+    }
+    std::string path = make_path(schema->data_out, filename);
+    FILE *file = fopen(path.c_str(), "w");
+    if (!file) {
+        log_message(schema, "Unexpected Error", "ORA-29283: invalid file operation", "EXPORT.ORDERS", 'E');
+        return -1;
+    }
+
+    int64_t rows = 0;
+    fprintf(file, "\"Order ID\",\"Order Ref\",\"Order Date\",\"Ship Date\",\"Comm Plan\",\"Total\",\"Customer ID\","
+                  "\"Customer Name\",\"Sales Rep\",\"Item\",\"Product ID\",\"Description\",\"Price\",\"Qty\",\"Item Total\"\n");
+
+    for (std::map<int32_t, ord_t>::iterator it = schema->ord.begin(); it != schema->ord.end(); ++it) {
+        const ord_t &order = it->second;
+
+        // Inner joins to CUSTOMER and EMP
+        std::unordered_map<int32_t, size_t>::iterator cust = schema->customer_idx.find(order.custid);
+        if (cust == schema->customer_idx.end()) continue;
+        const customer_t &customer = schema->customer[cust->second];
+        std::unordered_map<int32_t, size_t>::iterator rep = schema->emp_idx.find(customer.repid);
+        if (rep == schema->emp_idx.end()) continue;
+        const emp_t &emp = schema->emp[rep->second];
+
+        std::string header = std::to_string(order.ordid)
+            + ",\"" + (order.ordref.empty() ? std::string("No ref") : order.ordref) + "\""
+            + "," + format_date(order.orderdate)
+            + "," + format_date(order.shipdate)
+            + ",\"" + order.commplan + "\""
+            + "," + format_money(order.total)
+            + "," + std::to_string(order.custid)
+            + ",\"" + customer.name + "\""
+            + ",\"" + emp.ename + "\"";
+
+        if (order.items.empty()) {
+            // Outer join to ITEM and PRODUCT
+            fprintf(file, "%s,,,,,,\n", header.c_str());
+            rows++;
+            continue;
+        }
+        for (size_t i = 0; i < order.items.size(); i++) {
+            const item_t &item = order.items[i];
+            std::string descrip;
+            std::unordered_map<int32_t, size_t>::iterator prod = schema->product_idx.find(item.prodid);
+            if (prod != schema->product_idx.end()) {
+                descrip = get_field(schema->product[prod->second].descrip, 1, ',');
+            }
+            fprintf(file, "%s,%d,%d,%s,%s,%lld,%s\n", header.c_str(), item.itemid, item.prodid, descrip.c_str(),
+                    format_money(item.actualprice).c_str(), (long long)item.qty, format_money(item.itemtot).c_str());
+            rows++;
+        }
+    }
+
+    if (fclose(file) != 0) {
+        log_message(schema, "Unexpected Error", "ORA-29285: file write error", "EXPORT.ORDERS", 'E');
+        return -1;
+    }
+    return rows;
+}
@@ -0,0 +1,275 @@
+#ifndef ORDER_SCHEMA_H
+#define ORDER_SCHEMA_H
+
+#include <stdint.h>
+#include <time.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+
+/*
+  Program Name   : order_schema.h
+  Description    : In memory emulator of the sales order schema
+  Copyright      : Bond & Pollard Ltd 2025
+  Auther         : agent
+  Date           : 18 October 2026
+
+
+  A native stand-in for the order tables created by install_schema.sql, so that
+  order import and export can be run and measured without an Oracle database.
+
+  Tables: CUSTOMER, EMP, PRODUCT, PRICE, ORD, ITEM, IMPORTCSV, IMPORTERROR, APPLOG
+  Sequences: CUSTID_SEQ, ORDID_SEQ, PRODID_SEQ, IMPORTCSV_FILEID_SEQ
+
+  ord_imp() and export_orders() follow IMPORT.ORD_IMP and EXPORT.ORDERS:
+  the same validation rules and error messages, the same IMPORTERROR rows,
+  and the same movement of files between the DATA_IN, DATA_IN_PROCESSED and
+  DATA_IN_ERROR directories. Dates are held as YYYYMMDD, 0 is NULL.
+  Money is held in pence.
+
+  The steps of ORD_VALID and ORD_IMP are also exported, so that the import
+  coordinator in order_import.c can run them on many files at once.
+
+ */
+
+
+#define ORDREF_LENGTH     10     // ORD.ORDREF VARCHAR2(10)
+#define KEY_VALUE_LENGTH  30     // IMPORTCSV.KEY_VALUE VARCHAR2(30)
+#define ORDID_MAX         99999  // ORD.ORDID NUMBER(5,0)
+#define MONEY_MAX         99999999LL  // NUMBER(8,2) in pence
+#define QTY_MAX           99999999LL  // ITEM.QTY NUMBER(8,0)
+#define ORD_FIELD_COUNT   7      // Fields in an order CSV row
+
+// The checks ORD_VALID makes on each row, in the order it makes them
+enum {
+    CHECK_KEY_VALUE = 1, CHECK_ORDREF, CHECK_DUPLICATE, CHECK_ORDER_DATE, CHECK_COMMPLAN,
+    CHECK_CUSTOMER, CHECK_SHIP_DATE, CHECK_SHIP_AFTER_ORDER, CHECK_PRODUCT, CHECK_QTY
+};
+
+// Reasons ORD_IMP fails after the file has passed validation
+enum { FAIL_ORDID_EXCEEDED = 1, FAIL_PRECISION, FAIL_NULL_ORDID };
+
+typedef struct {
+    int32_t     custid;
+    std::string name;
+    int32_t     repid;
+} customer_t;
+
+typedef struct {
+    int32_t     empno;
+    std::string ename;
+} emp_t;
+
+typedef struct {
+    int32_t     prodid;
+    std::string descrip;
+} product_t;
+
+typedef struct {
+    int32_t     prodid;
+    int64_t     stdprice;
+    int64_t     minprice;
+    int32_t     startdate;
+    int32_t     enddate;
+} price_t;
+
+typedef struct {
+    int32_t     ordid;
+    int32_t     itemid;
+    int32_t     prodid;
+    int64_t     actualprice;
+    int64_t     qty;
+    int64_t     itemtot;
+} item_t;
+
+typedef struct {
+    int32_t     ordid;
+    int32_t     orderdate;
+    std::string ordref;
+    std::string commplan;
+    int32_t     custid;
+    int32_t     shipdate;
+    int64_t     total;
+    std::vector<item_t> items;   // ITEM rows for the order, in ITEMID order
+} ord_t;
+
+typedef struct {
+    int64_t     recid;
+    int64_t     fileid;
+    std::string filename;
+    std::string csv_rec;
+    std::string key_value;
+} importcsv_t;
+
+typedef struct {
+    int64_t     recid;
+    std::string filename;
+    std::string error_data;
+    std::string error_message;
+    time_t      error_time;
+    std::string user_name;
+    std::string key_value;
+    std::string import_sqlerrm;
+    bool        deleted;
+} importerror_t;
+
+typedef struct {
+    int64_t     recid;
+    std::string message;
+    time_t      logged_at;
+    std::string user_name;
+    std::string applog_sqlerrm;
+    std::string program_name;
+    char        severity;
+} applog_t;
+
+// An IMPORTERROR row for one of the ORD_VALID checks
+typedef struct {
+    int         check;
+    std::string message;
+    std::string key_value;
+} row_error_t;
+
+// ORD_VALID locals carried from row to row, a failed assignment keeps the previous value
+typedef struct {
+    std::string key_value;
+    int32_t     orderdate;
+    int32_t     shipdate;
+} ord_valid_state_t;
+
+// Elapsed time of each stage of ord_imp, in microseconds
+typedef struct {
+    int64_t     load_us;
+    int64_t     validate_us;
+    int64_t     insert_us;
+    int64_t     rows;
+} ord_imp_stats_t;
+
+typedef struct {
+    // Directories, as created by install_schema.sql
+    std::string data_home;
+    std::string data_in;
+    std::string data_in_error;
+    std::string data_in_processed;
+    std::string data_out;
+
+    // Tables and their indexes
+    std::vector<customer_t>             customer;
+    std::unordered_map<int32_t, size_t> customer_idx;
+    std::vector<emp_t>                  emp;
+    std::unordered_map<int32_t, size_t> emp_idx;
+    std::vector<product_t>              product;
+    std::unordered_map<int32_t, size_t> product_idx;
+    std::vector<price_t>                price;
+    std::unordered_map<int32_t, std::vector<size_t> > price_idx;     // By PRODID
+    std::map<int32_t, ord_t>            ord;                          // By ORDID
+    std::unordered_set<std::string>     ord_ordref;
+    std::vector<importcsv_t>            importcsv;
+    std::vector<importerror_t>          importerror;
+    std::unordered_multimap<std::string, size_t> importerror_key;     // By KEY_VALUE
+    std::vector<applog_t>               applog;
+
+    // Sequences and identity columns
+    int64_t     custid_seq;
+    int64_t     ordid_seq;
+    int64_t     prodid_seq;
+    int64_t     importcsv_fileid_seq;
+    int64_t     importcsv_recid;
+    int64_t     importerror_recid;
+    int64_t     applog_recid;
+
+    int32_t     sysdate;       // Current date used for price lookups, YYYYMMDD
+    int32_t     ordid_max;     // Largest ORDID that fits ORD.ORDID
+    std::string user_name;
+} order_schema_t;
+
+
+// Set up an empty schema using the directories under data_home, as install_schema.sql does
+void schema_init(order_schema_t *schema, const char *data_home);
+
+// Full path of a file in one of the directories
+std::string make_path(const std::string &directory, const char *filename);
+
+// Create DATA_HOME and the DATA_IN, DATA_IN\processed, DATA_IN\error and DATA_OUT directories
+bool schema_create_directories(order_schema_t *schema);
+
+// Insert reference data. Pass 0 for custid or prodid to take the next sequence value.
+int32_t insert_customer(order_schema_t *schema, int32_t custid, const char *name, int32_t repid);
+void    insert_emp(order_schema_t *schema, int32_t empno, const char *ename);
+int32_t insert_product(order_schema_t *schema, int32_t prodid, const char *descrip);
+void    insert_price(order_schema_t *schema, int32_t prodid, int64_t stdprice, int64_t minprice,
+                     int32_t startdate, int32_t enddate);
+
+// UTIL_ADMIN.LOG_MESSAGE with log mode F, write to APPLOG
+void log_message(order_schema_t *schema, const char *message, const char *sqlerrm,
+                 const char *program_name, char severity);
+
+// ORDERRP.CURRENTPRICE
+int64_t currentprice(const order_schema_t *schema, int32_t prodid);
+
+// UTIL_STRING.GET_FIELD, 1 based field position
+std::string get_field(const std::string &rec, int position, char delimiter);
+
+// UTIL_STRING.GET_FIELD for every field of the record
+void split_fields(const std::string &rec, char delimiter, std::vector<std::string> &fields);
+
+// TO_DATE(text, 'DD/MM/YYYY'), returns false if text is not a valid date
+bool parse_date(const std::string &text, int32_t *date);
+
+// IMPORT.IMPORT_ERROR
+void import_error(order_schema_t *schema, const std::string &filename, const std::string &rec,
+                  const std::string &message, const std::string &key_value, const char *sqlerrm);
+
+// IMPORT.DELETE_ERROR for one order, an empty key_value is ignored
+void delete_error(order_schema_t *schema, const std::string &key_value);
+
+// UTIL_FILE.RENAME_FILE, errors are logged not raised
+void rename_file(order_schema_t *schema, const std::string &src_location, const char *filename,
+                 const std::string &dest_location);
+
+// Read a file's records as UTIL_FILE.LOAD_CSV does. Returns 1, -1 if the file was not found, or 0
+// if a record is too long for IMPORTCSV.CSV_REC, when only the records before it are returned.
+int read_csv(const std::string &path, std::vector<std::string> &records);
+
+// Records the ORD_VALID and ORD_IMP cursors select: not the header, and not empty
+bool is_order_record(const std::string &csv_rec);
+
+// Assign the ORD_VALID locals from the next row, fields split and sized to ORD_FIELD_COUNT
+void ord_valid_next(ord_valid_state_t *state, const std::vector<std::string> &fields);
+
+// The ORD_VALID checks on a row, after ord_valid_next. Adds errors in the order ORD_VALID records
+// them and returns false if there were any. ORDREF is checked for duplicates against ordrefs, if not NULL.
+bool ord_valid_row(const order_schema_t *schema, const std::vector<std::string> &fields,
+                   const ord_valid_state_t *state, const std::unordered_set<std::string> *ordrefs,
+                   std::vector<row_error_t> &errors);
+
+// Start an order from the row that has its ORDREF, as ORD_IMP inserts into ORD
+void start_order(ord_t *order, const std::vector<std::string> &fields);
+
+// Add the row to the order as an ITEM. Returns false if ITEMTOT or TOTAL is too large.
+bool add_item(const order_schema_t *schema, ord_t *order, const std::vector<std::string> &fields);
+
+// ORDID_SEQ.NEXTVAL, or 0 if the value is too large for ORD.ORDID
+int32_t next_ordid(order_schema_t *schema);
+
+// Insert a started order and its items into ORD and ITEM. The order is left empty.
+void insert_order(order_schema_t *schema, ord_t *order, int32_t ordid);
+
+// How ORD_IMP ends for a file that is not found, fails validation, or fails with reason FAIL_*
+// while inserting current_rec. The last two move the file to DATA_IN_ERROR.
+void ord_imp_not_found(order_schema_t *schema, const char *filename);
+void ord_imp_invalid(order_schema_t *schema, const char *filename);
+void ord_imp_failed(order_schema_t *schema, const char *filename, const std::string &current_rec, int reason);
+
+// IMPORT.ORD_IMP. Import an order CSV file from DATA_IN. stats may be NULL.
+bool ord_imp(order_schema_t *schema, const char *filename, ord_imp_stats_t *stats);
+
+// EXPORT.ORDERS. Write all orders to filename in DATA_OUT, returns rows written or -1.
+int64_t export_orders(order_schema_t *schema, const char *filename);
+
+// Count of IMPORTERROR rows not deleted
+int64_t importerror_count(order_schema_t *schema);
+
+#endif
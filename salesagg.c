@@ -0,0 +1,915 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <ctype.h>
+#include <time.h>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/*
+  Program Name   : salesagg.c
+  Description    : Incrementally maintained sales aggregates
+  Copyright      : Bond & Pollard Ltd 2025
+  Auther         : agent
+  Date           : 18 October 2026
+
+
+  Maintains per-customer, per-product and per-day sales totals in a compact
+  memory mapped file, so that the sales reports can be answered with a single
+  hash lookup per key instead of a full scan of ORD and ITEM.
+
+  The input is an order extract in the CSV layout written by EXPORT.ORDERS.
+  After each IMPORT.ORD_IMP batch run EXPORT.ORDER_BATCH passing the watermark
+  reported by this program, and apply the extract file. import_order.bat does
+  this at the end of every run:
+
+    salesagg apply     <store> <orders.csv>          Add new orders to the aggregates
+    salesagg watermark <store>                       ORDID to pass to EXPORT.ORDER_BATCH
+    salesagg query     <store> customer|product|day <key>
+    salesagg report    <store> customer|product|day  List every aggregate row
+    salesagg snapshot  <store> <snapshot file>       Consistent copy of the store
+    salesagg reconcile <store> <orders.csv>          Compare against a full recompute
+
+  Every ORDID up to the watermark has been applied or was never committed. ORDID
+  is allocated from ORDID_SEQ when an order is inserted, not when it commits, so
+  two imports running at once can commit ORDID 105 before ORDID 104. The store
+  keeps the ORDIDs above the watermark that have been applied, and the ones still
+  missing, in a pending list. An applied ORDID is never counted twice, so
+  re-applying an extract, or applying a full EXPORT.ORDERS file, does not double
+  count. The watermark only moves past a missing ORDID once it has been missing
+  for AGG_SETTLE_SECS, when it is taken to be a sequence gap (a rolled back
+  import or lost cached sequence values). An order committed later than that is
+  not applied and will be reported by reconcile, rebuild the store to include it.
+  Day keys are entered as DD/MM/YYYY, the same format as the CSV files.
+
+  query and report replace a scan of ORD and ITEM for sales totals by customer,
+  product or day. The SQL*Plus reports orders.sql and productprices_RP.sql, and
+  the ORDERRP price functions, are unchanged: they list single orders and prices,
+  which the aggregates do not hold, so they still read ORD, ITEM and PRICE.
+
+  The watermark of a store that does not exist yet is 0, so the first run
+  exports and applies every order.
+
+  Build: g++ -O2 -o salesagg.exe salesagg.c
+
+ */
+
+
+#define AGG_MAGIC          "SALESAGG"
+#define AGG_VERSION        2
+#define AGG_TABLES         3
+#define AGG_INITIAL_SLOTS  1024
+#define AGG_MAX_LOAD_PCT   70
+#define AGG_FIELD_COUNT    15
+#define AGG_SETTLE_SECS    3600       // Time a missing ORDID is waited for before it is treated as a gap
+
+enum agg_table_t { AGG_CUSTOMER = 0, AGG_PRODUCT = 1, AGG_DAY = 2 };
+
+static const char *agg_table_name[AGG_TABLES] = { "customer", "product", "day" };
+
+// File header, followed by the customer, product and day hash tables and the pending list
+typedef struct {
+    char     magic[8];
+    uint32_t version;
+    uint32_t dirty;                    // Set while a batch is being applied
+    int64_t  watermark_ordid;          // Every ORDID up to here is applied or is a gap
+    int64_t  max_ordid;                // Highest ORDID applied
+    int64_t  batches_applied;
+    uint32_t capacity[AGG_TABLES];     // Slots in each table, always a power of 2
+    uint32_t count[AGG_TABLES];        // Slots in use
+    uint32_t pending_capacity;
+    uint32_t pending_count;
+} agg_header_t;
+
+// An ORDID above the watermark, in ORDID order. Every ORDID from the watermark up to
+// max_ordid has an entry.
+typedef struct {
+    int64_t  ordid;
+    int64_t  missing_since;            // 0 once applied, else when the ORDID was first found missing
+} agg_pending_t;
+
+typedef std::map<int64_t, int64_t> agg_pending_map_t;   // ORDID to missing_since
+
+// One aggregate row. Money is held in pence to avoid rounding drift.
+typedef struct {
+    int32_t  key;                      // CUSTID, PRODID or order date as YYYYMMDD
+    uint32_t used;
+    int64_t  orders;                   // Distinct orders
+    int64_t  items;                    // ITEM rows
+    int64_t  qty;                      // Sum of ITEM.QTY
+    int64_t  item_total;               // Sum of ITEM.ITEMTOT
+    int64_t  ord_total;                // Sum of ORD.TOTAL, customer and day only
+} agg_entry_t;
+
+typedef struct {
+    char          path[1024];
+    size_t        size;
+    unsigned char *base;
+#ifdef _WIN32
+    HANDLE        file;
+    HANDLE        mapping;
+#else
+    int           fd;
+#endif
+} agg_store_t;
+
+// Aggregates for a batch or a full recompute, held in memory before being applied
+typedef std::unordered_map<int32_t, agg_entry_t> agg_map_t;
+
+typedef struct {
+    agg_map_t table[AGG_TABLES];
+    std::vector<int64_t> ordids;       // ORDIDs of the orders in the batch
+    int64_t   max_ordid = 0;
+    int64_t   orders = 0;
+    int64_t   rows = 0;
+    int64_t   skipped = 0;             // Rows of orders already applied
+    int64_t   total_mismatch = 0;      // Orders where ORD.TOTAL <> sum of ITEMTOT
+} agg_batch_t;
+
+
+static agg_header_t *store_header(agg_store_t *store) {
+    return (agg_header_t *)store->base;
+}
+
+static agg_entry_t *store_table(agg_store_t *store, int table) {
+    agg_header_t *header = store_header(store);
+    size_t offset = sizeof(agg_header_t);
+    for (int i = 0; i < table; i++) {
+        offset += header->capacity[i] * sizeof(agg_entry_t);
+    }
+    return (agg_entry_t *)(store->base + offset);
+}
+
+static agg_pending_t *store_pending(agg_store_t *store) {
+    return (agg_pending_t *)store_table(store, AGG_TABLES);
+}
+
+static size_t store_size(const uint32_t *capacity, uint32_t pending_capacity) {
+    size_t size = sizeof(agg_header_t);
+    for (int i = 0; i < AGG_TABLES; i++) {
+        size += capacity[i] * sizeof(agg_entry_t);
+    }
+    return size + pending_capacity * sizeof(agg_pending_t);
+}
+
+static uint32_t hash_key(int32_t key) {
+    uint32_t h = (uint32_t)key;
+    h ^= h >> 16;
+    h *= 0x7feb352dU;
+    h ^= h >> 15;
+    h *= 0x846ca68bU;
+    h ^= h >> 16;
+    return h;
+}
+
+// Map an existing file of the given size into memory
+static bool map_file(agg_store_t *store, const char *path, size_t size, bool create) {
+    snprintf(store->path, sizeof(store->path), "%s", path);
+    store->size = size;
+#ifdef _WIN32
+    store->file = CreateFile(path, GENERIC_READ | GENERIC_WRITE, 0, NULL,
+                             create ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (store->file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    if (create) {
+        LARGE_INTEGER new_size;
+        new_size.QuadPart = (LONGLONG)size;
+        SetFilePointerEx(store->file, new_size, NULL, FILE_BEGIN);
+        SetEndOfFile(store->file);
+    }
+    store->mapping = CreateFileMapping(store->file, NULL, PAGE_READWRITE, 0, 0, NULL);
+    if (store->mapping == NULL) {
+        CloseHandle(store->file);
+        return false;
+    }
+    store->base = (unsigned char *)MapViewOfFile(store->mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (store->base == NULL) {
+        CloseHandle(store->mapping);
+        CloseHandle(store->file);
+        return false;
+    }
+#else
+    store->fd = open(path, create ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDWR, 0644);
+    if (store->fd < 0) {
+        return false;
+    }
+    if (create && ftruncate(store->fd, (off_t)size) != 0) {
+        close(store->fd);
+        return false;
+    }
+    void *base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, store->fd, 0);
+    if (base == MAP_FAILED) {
+        close(store->fd);
+        return false;
+    }
+    store->base = (unsigned char *)base;
+#endif
+    return true;
+}
+
+static void flush_store(agg_store_t *store) {
+#ifdef _WIN32
+    FlushViewOfFile(store->base, store->size);
+    FlushFileBuffers(store->file);
+#else
+    msync(store->base, store->size, MS_SYNC);
+#endif
+}
+
+static void close_store(agg_store_t *store) {
+    if (store->base == NULL) {
+        return;
+    }
+    flush_store(store);
+#ifdef _WIN32
+    UnmapViewOfFile(store->base);
+    CloseHandle(store->mapping);
+    CloseHandle(store->file);
+#else
+    munmap(store->base, store->size);
+    close(store->fd);
+#endif
+    store->base = NULL;
+}
+
+static bool file_size(const char *path, size_t *size) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    fseek(file, 0, SEEK_END);
+    *size = (size_t)ftell(file);
+    fclose(file);
+    return true;
+}
+
+// Replace path with temp_path in one step, so a crash leaves either the old file or the new one
+static bool replace_file(const char *temp_path, const char *path) {
+#ifdef _WIN32
+    return MoveFileEx(temp_path, path, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return rename(temp_path, path) == 0;
+#endif
+}
+
+// Create an empty store with the given table capacities
+static bool create_store(agg_store_t *store, const char *path, const uint32_t *capacity, uint32_t pending_capacity) {
+    if (!map_file(store, path, store_size(capacity, pending_capacity), true)) {
+        printf("Error: Could not create aggregate store %s\n", path);
+        return false;
+    }
+    memset(store->base, 0, store->size);
+    agg_header_t *header = store_header(store);
+    memcpy(header->magic, AGG_MAGIC, sizeof(header->magic));
+    header->version = AGG_VERSION;
+    for (int i = 0; i < AGG_TABLES; i++) {
+        header->capacity[i] = capacity[i];
+    }
+    header->pending_capacity = pending_capacity;
+    return true;
+}
+
+// Open the store, optionally creating it if it does not exist
+static bool open_store(agg_store_t *store, const char *path, bool create) {
+    size_t size;
+    memset(store, 0, sizeof(*store));
+    if (!file_size(path, &size)) {
+        if (!create) {
+            printf("Error: Aggregate store %s not found.\n", path);
+            return false;
+        }
+        uint32_t capacity[AGG_TABLES] = { AGG_INITIAL_SLOTS, AGG_INITIAL_SLOTS, AGG_INITIAL_SLOTS };
+        return create_store(store, path, capacity, AGG_INITIAL_SLOTS);
+    }
+    if (size < sizeof(agg_header_t) || !map_file(store, path, size, false)) {
+        printf("Error: Could not open aggregate store %s\n", path);
+        return false;
+    }
+    agg_header_t *header = store_header(store);
+    if (memcmp(header->magic, AGG_MAGIC, sizeof(header->magic)) != 0) {
+        printf("Error: %s is not a sales aggregate store.\n", path);
+        close_store(store);
+        return false;
+    }
+    if (header->version != AGG_VERSION) {
+        printf("Error: %s was written by an older version of salesagg. Rebuild it from a full EXPORT.ORDERS file.\n", path);
+        close_store(store);
+        return false;
+    }
+    if (store_size(header->capacity, header->pending_capacity) != size) {
+        printf("Error: %s is not a sales aggregate store.\n", path);
+        close_store(store);
+        return false;
+    }
+    if (header->dirty) {
+        printf("Error: %s was left part way through applying a batch. Restore a snapshot or rebuild it.\n", path);
+        close_store(store);
+        return false;
+    }
+    return true;
+}
+
+static agg_entry_t *find_slot(agg_entry_t *table, uint32_t capacity, int32_t key) {
+    uint32_t mask = capacity - 1;
+    uint32_t slot = hash_key(key) & mask;
+    while (table[slot].used && table[slot].key != key) {
+        slot = (slot + 1) & mask;
+    }
+    return &table[slot];
+}
+
+// Return the aggregate row for a key, or NULL if there is none
+static const agg_entry_t *lookup(agg_store_t *store, int table, int32_t key) {
+    agg_entry_t *entry = find_slot(store_table(store, table), store_header(store)->capacity[table], key);
+    return entry->used ? entry : NULL;
+}
+
+// Rebuild the store with enough room for the extra keys, keeping the load factor below AGG_MAX_LOAD_PCT,
+// and for the given number of pending ORDIDs
+static bool reserve_store(agg_store_t *store, const uint32_t *extra, size_t pending) {
+    agg_header_t *header = store_header(store);
+    uint32_t capacity[AGG_TABLES];
+    uint32_t pending_capacity = header->pending_capacity;
+    bool grow = false;
+
+    for (int i = 0; i < AGG_TABLES; i++) {
+        capacity[i] = header->capacity[i];
+        while ((uint64_t)(header->count[i] + extra[i]) * 100 > (uint64_t)capacity[i] * AGG_MAX_LOAD_PCT) {
+            capacity[i] *= 2;
+            grow = true;
+        }
+    }
+    while (pending > pending_capacity) {
+        pending_capacity *= 2;
+        grow = true;
+    }
+    if (!grow) {
+        return true;
+    }
+
+    char temp_path[1100];
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", store->path);
+    agg_store_t bigger;
+    memset(&bigger, 0, sizeof(bigger));
+    if (!create_store(&bigger, temp_path, capacity, pending_capacity)) {
+        return false;
+    }
+    agg_header_t *new_header = store_header(&bigger);
+    new_header->watermark_ordid = header->watermark_ordid;
+    new_header->max_ordid = header->max_ordid;
+    new_header->batches_applied = header->batches_applied;
+    new_header->pending_count = header->pending_count;
+    memcpy(store_pending(&bigger), store_pending(store), header->pending_count * sizeof(agg_pending_t));
+    for (int i = 0; i < AGG_TABLES; i++) {
+        agg_entry_t *old_table = store_table(store, i);
+        agg_entry_t *new_table = store_table(&bigger, i);
+        for (uint32_t slot = 0; slot < header->capacity[i]; slot++) {
+            if (old_table[slot].used) {
+                *find_slot(new_table, capacity[i], old_table[slot].key) = old_table[slot];
+            }
+        }
+        new_header->count[i] = header->count[i];
+    }
+
+    char path[1024];
+    snprintf(path, sizeof(path), "%s", store->path);
+    close_store(&bigger);
+    close_store(store);
+    if (!replace_file(temp_path, path)) {
+        printf("Error: Could not replace %s with %s\n", path, temp_path);
+        return false;
+    }
+    return open_store(store, path, false);
+}
+
+// Split a CSV record into fields, as UTIL_STRING.GET_FIELD does:
+// delimiters inside double quotes are ignored, fields are trimmed and enclosing quotes removed.
+static int split_csv(char *rec, char **fields, int max_fields) {
+    int count = 0;
+    char *p = rec;
+    while (count < max_fields) {
+        char *start = p;
+        bool quotes_open = false;
+        while (*p && (quotes_open || *p != ',') && *p != '\n' && *p != '\r') {
+            if (*p == '"') {
+                quotes_open = !quotes_open;
+            }
+            p++;
+        }
+        char end_char = *p;
+        *p = '\0';
+
+        while (*start == ' ') start++;
+        char *end = start + strlen(start);
+        while (end > start && end[-1] == ' ') end--;
+        if (end - start >= 2 && *start == '"' && end[-1] == '"') {
+            start++;
+            end--;
+        }
+        *end = '\0';
+        fields[count++] = start;
+
+        if (end_char != ',') {
+            break;
+        }
+        p++;
+    }
+    return count;
+}
+
+// Convert a decimal string such as 1234.5 to pence. More than two decimal places is an error,
+// NUMBER(8,2) columns never export them so the row is malformed.
+static bool parse_money(const char *text, int64_t *pence) {
+    int64_t whole = 0, fraction = 0;
+    int digits = 0, whole_digits = 0, sign = 1;
+    const char *p = text;
+    if (*p == '-') {
+        sign = -1;
+        p++;
+    }
+    if (!*p) {
+        *pence = 0;
+        return sign > 0;                // Empty for an order with no items
+    }
+    while (isdigit((unsigned char)*p)) {
+        if (++whole_digits > 16) {
+            return false;
+        }
+        whole = whole * 10 + (*p++ - '0');
+    }
+    if (*p == '.') {
+        p++;
+        while (isdigit((unsigned char)*p)) {
+            if (++digits > 2) {
+                return false;
+            }
+            fraction = fraction * 10 + (*p++ - '0');
+        }
+    }
+    if (*p || whole_digits + digits == 0) {
+        return false;
+    }
+    while (digits++ < 2) fraction *= 10;
+    *pence = sign * (whole * 100 + fraction);
+    return true;
+}
+
+// Convert DD/MM/YYYY to YYYYMMDD, rejecting dates that do not exist such as 31/02
+static bool parse_date(const char *text, int32_t *key) {
+    static const int days_in_month[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    int day, month, year;
+    char extra;
+    if (sscanf(text, "%d/%d/%d%c", &day, &month, &year, &extra) != 3
+        || day < 1 || month < 1 || month > 12 || year < 1 || year > 9999) {
+        return false;
+    }
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    if (day > days_in_month[month - 1] + (month == 2 && leap ? 1 : 0)) {
+        return false;
+    }
+    *key = year * 10000 + month * 100 + day;
+    return true;
+}
+
+static agg_entry_t *batch_entry(agg_batch_t *batch, int table, int32_t key) {
+    agg_entry_t &entry = batch->table[table][key];
+    if (!entry.used) {
+        memset(&entry, 0, sizeof(entry));
+        entry.key = key;
+        entry.used = 1;
+    }
+    return &entry;
+}
+
+// Read an EXPORT.ORDERS layout CSV file, aggregating orders with ORDID above the watermark
+// that are not in applied. Rows must be in ORDID, ITEMID order, which is how EXPORT.ORDERS writes them.
+static bool load_orders(const char *filename, int64_t watermark, const std::unordered_set<int64_t> *applied,
+                        agg_batch_t *batch) {
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        printf("Error: Could not open %s\n", filename);
+        return false;
+    }
+
+    char rec[4096];
+    char *fields[AGG_FIELD_COUNT];
+    long line_no = 0;
+    int64_t current_ordid = -1;
+    int64_t current_total = 0, current_items = 0;
+    std::vector<int32_t> order_products;  // Products already counted for the current order
+
+    batch->max_ordid = watermark;
+    while (fgets(rec, sizeof(rec), file)) {
+        line_no++;
+        if (strncmp(rec, "\"Order ID\"", 10) == 0 || rec[0] == '\n' || rec[0] == '\r') {
+            continue;
+        }
+        if (split_csv(rec, fields, AGG_FIELD_COUNT) != AGG_FIELD_COUNT) {
+            printf("Error: %s line %ld does not have %d fields.\n", filename, line_no, AGG_FIELD_COUNT);
+            fclose(file);
+            return false;
+        }
+
+        int64_t ordid = atoll(fields[0]);
+        if (ordid <= watermark || (applied && applied->count(ordid))) {
+            batch->skipped++;
+            continue;
+        }
+
+        int32_t custid = atoi(fields[6]);
+        int32_t day;
+        int64_t ord_total, price, itemtot;
+        if (!parse_date(fields[2], &day) || !parse_money(fields[5], &ord_total)
+            || !parse_money(fields[12], &price) || !parse_money(fields[14], &itemtot)) {
+            printf("Error: %s line %ld has an invalid date or amount.\n", filename, line_no);
+            fclose(file);
+            return false;
+        }
+
+        if (ordid != current_ordid) {
+            // New order. Check the previous order total agrees with its items.
+            if (current_ordid != -1 && current_total != current_items) {
+                batch->total_mismatch++;
+            }
+            current_ordid = ordid;
+            current_total = ord_total;
+            current_items = 0;
+            order_products.clear();
+            batch->orders++;
+            batch->ordids.push_back(ordid);
+            if (ordid > batch->max_ordid) {
+                batch->max_ordid = ordid;
+            }
+
+            agg_entry_t *customer = batch_entry(batch, AGG_CUSTOMER, custid);
+            agg_entry_t *order_day = batch_entry(batch, AGG_DAY, day);
+            customer->orders++;
+            customer->ord_total += ord_total;
+            order_day->orders++;
+            order_day->ord_total += ord_total;
+        }
+        batch->rows++;
+
+        // Orders without items are exported with empty ITEM columns
+        if (fields[9][0] == '\0') {
+            continue;
+        }
+        int32_t prodid = atoi(fields[10]);
+        int64_t qty = atoll(fields[13]);
+        current_items += itemtot;
+
+        agg_entry_t *product = batch_entry(batch, AGG_PRODUCT, prodid);
+        bool counted = false;
+        for (size_t i = 0; i < order_products.size(); i++) {
+            if (order_products[i] == prodid) counted = true;
+        }
+        if (!counted) {
+            order_products.push_back(prodid);
+            product->orders++;
+        }
+
+        agg_entry_t *targets[AGG_TABLES] = { batch_entry(batch, AGG_CUSTOMER, custid), product,
+                                             batch_entry(batch, AGG_DAY, day) };
+        for (int i = 0; i < AGG_TABLES; i++) {
+            targets[i]->items++;
+            targets[i]->qty += qty;
+            targets[i]->item_total += itemtot;
+        }
+    }
+    if (current_ordid != -1 && current_total != current_items) {
+        batch->total_mismatch++;
+    }
+
+    fclose(file);
+    return true;
+}
+
+// ORDIDs above the watermark that have been applied
+static void applied_ordids(agg_store_t *store, std::unordered_set<int64_t> &applied) {
+    agg_pending_t *pending = store_pending(store);
+    for (uint32_t i = 0; i < store_header(store)->pending_count; i++) {
+        if (pending[i].missing_since == 0) {
+            applied.insert(pending[i].ordid);
+        }
+    }
+}
+
+// Work out the pending list and watermark after applying the batch. The watermark moves up
+// over ORDIDs that have been applied and ORDIDs that have been missing for AGG_SETTLE_SECS.
+static int64_t next_pending(agg_store_t *store, const agg_batch_t *batch, time_t now, agg_pending_map_t &pending) {
+    agg_header_t *header = store_header(store);
+    agg_pending_t *entries = store_pending(store);
+    int64_t watermark = header->watermark_ordid;
+    int64_t high = header->max_ordid > batch->max_ordid ? header->max_ordid : batch->max_ordid;
+
+    for (uint32_t i = 0; i < header->pending_count; i++) {
+        pending[entries[i].ordid] = entries[i].missing_since;
+    }
+    for (size_t i = 0; i < batch->ordids.size(); i++) {
+        pending[batch->ordids[i]] = 0;
+    }
+    if (header->max_ordid == 0) {
+        // The first orders come from a full extract, there is nothing earlier to wait for
+        pending.clear();
+        return high;
+    }
+    for (int64_t ordid = watermark + 1; ordid <= high; ordid++) {
+        if (pending.find(ordid) == pending.end()) {
+            pending[ordid] = (int64_t)now;
+        }
+    }
+    while (!pending.empty() && pending.begin()->first == watermark + 1
+           && (pending.begin()->second == 0 || now - pending.begin()->second >= AGG_SETTLE_SECS)) {
+        watermark++;
+        pending.erase(pending.begin());
+    }
+    return watermark;
+}
+
+// Add the batch aggregates into the store and advance the watermark
+static bool apply_batch(agg_store_t *store, agg_batch_t *batch) {
+    agg_pending_map_t pending;
+    int64_t watermark = next_pending(store, batch, time(NULL), pending);
+
+    uint32_t extra[AGG_TABLES];
+    for (int i = 0; i < AGG_TABLES; i++) {
+        extra[i] = (uint32_t)batch->table[i].size();
+    }
+    if (!reserve_store(store, extra, pending.size())) {
+        return false;
+    }
+
+    agg_header_t *header = store_header(store);
+    header->dirty = 1;
+    flush_store(store);
+
+    for (int i = 0; i < AGG_TABLES; i++) {
+        agg_entry_t *table = store_table(store, i);
+        for (agg_map_t::iterator it = batch->table[i].begin(); it != batch->table[i].end(); ++it) {
+            agg_entry_t *entry = find_slot(table, header->capacity[i], it->first);
+            if (!entry->used) {
+                memset(entry, 0, sizeof(*entry));
+                entry->key = it->first;
+                entry->used = 1;
+                header->count[i]++;
+            }
+            entry->orders     += it->second.orders;
+            entry->items      += it->second.items;
+            entry->qty        += it->second.qty;
+            entry->item_total += it->second.item_total;
+            entry->ord_total  += it->second.ord_total;
+        }
+    }
+    agg_pending_t *entries = store_pending(store);
+    header->pending_count = 0;
+    for (agg_pending_map_t::iterator it = pending.begin(); it != pending.end(); ++it) {
+        entries[header->pending_count].ordid = it->first;
+        entries[header->pending_count].missing_since = it->second;
+        header->pending_count++;
+    }
+    header->watermark_ordid = watermark;
+    if (batch->max_ordid > header->max_ordid) {
+        header->max_ordid = batch->max_ordid;
+    }
+    header->batches_applied++;
+    flush_store(store);
+
+    header->dirty = 0;
+    flush_store(store);
+    return true;
+}
+
+// Copy the store to a snapshot file. The copy is written to a temporary file and renamed
+// so that an existing snapshot is only replaced by a complete one.
+static bool snapshot_store(agg_store_t *store, const char *snapshot) {
+    char temp_path[1100];
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", snapshot);
+
+    flush_store(store);
+    FILE *file = fopen(temp_path, "wb");
+    if (!file) {
+        printf("Error: Could not open %s for writing.\n", temp_path);
+        return false;
+    }
+    bool ok = fwrite(store->base, 1, store->size, file) == store->size;
+    ok = (fflush(file) == 0) && ok;
+    fclose(file);
+    if (!ok) {
+        printf("Error: Could not write snapshot %s\n", temp_path);
+        remove(temp_path);
+        return false;
+    }
+    if (!replace_file(temp_path, snapshot)) {
+        printf("Error: Could not rename %s to %s\n", temp_path, snapshot);
+        return false;
+    }
+    return true;
+}
+
+static void format_money(int64_t pence, char *buffer, size_t size) {
+    const char *sign = pence < 0 ? "-" : "";
+    if (pence < 0) pence = -pence;
+    snprintf(buffer, size, "%s%lld.%02lld", sign, (long long)(pence / 100), (long long)(pence % 100));
+}
+
+static void format_key(int table, int32_t key, char *buffer, size_t size) {
+    if (table == AGG_DAY) {
+        snprintf(buffer, size, "%02d/%02d/%04d", key % 100, (key / 100) % 100, key / 10000);
+    } else {
+        snprintf(buffer, size, "%d", key);
+    }
+}
+
+static void print_heading(int table) {
+    printf("%-10s %10s %10s %12s %14s %14s\n", agg_table_name[table], "Orders", "Items", "Qty", "Item Total",
+           table == AGG_PRODUCT ? "" : "Order Total");
+}
+
+static void print_entry(int table, const agg_entry_t *entry) {
+    char key[16], item_total[32], ord_total[32];
+    format_key(table, entry->key, key, sizeof(key));
+    format_money(entry->item_total, item_total, sizeof(item_total));
+    format_money(entry->ord_total, ord_total, sizeof(ord_total));
+    printf("%-10s %10lld %10lld %12lld %14s %14s\n", key, (long long)entry->orders, (long long)entry->items,
+           (long long)entry->qty, item_total, table == AGG_PRODUCT ? "" : ord_total);
+}
+
+static int table_from_name(const char *name) {
+    for (int i = 0; i < AGG_TABLES; i++) {
+        if (strcmp(name, agg_table_name[i]) == 0) {
+            return i;
+        }
+    }
+    printf("Error: Unknown aggregate %s, must be customer, product or day.\n", name);
+    return -1;
+}
+
+static bool same_entry(const agg_entry_t *a, const agg_entry_t *b) {
+    return a->orders == b->orders && a->items == b->items && a->qty == b->qty
+        && a->item_total == b->item_total && a->ord_total == b->ord_total;
+}
+
+// Recompute every aggregate from a full order extract and compare with the store
+static int reconcile(agg_store_t *store, const char *filename) {
+    agg_batch_t full;
+    int differences = 0;
+
+    if (!load_orders(filename, 0, NULL, &full)) {
+        return -1;
+    }
+    if (full.max_ordid != store_header(store)->max_ordid) {
+        printf("Highest ORDID: store has ORDID %lld, extract goes up to ORDID %lld\n",
+               (long long)store_header(store)->max_ordid, (long long)full.max_ordid);
+        differences++;
+    }
+
+    for (int i = 0; i < AGG_TABLES; i++) {
+        agg_header_t *header = store_header(store);
+        agg_entry_t *table = store_table(store, i);
+
+        // Every recomputed row must be in the store with the same values
+        for (agg_map_t::iterator it = full.table[i].begin(); it != full.table[i].end(); ++it) {
+            const agg_entry_t *stored = lookup(store, i, it->first);
+            if (stored == NULL || !same_entry(stored, &it->second)) {
+                printf("Mismatch on %s aggregate:\n", agg_table_name[i]);
+                print_heading(i);
+                printf("Store:\n");
+                if (stored) print_entry(i, stored);
+                printf("Recomputed:\n");
+                print_entry(i, &it->second);
+                differences++;
+            }
+        }
+        // The store must not hold rows the recompute did not produce
+        for (uint32_t slot = 0; slot < header->capacity[i]; slot++) {
+            if (table[slot].used && full.table[i].find(table[slot].key) == full.table[i].end()) {
+                printf("Mismatch on %s aggregate, not found by recompute:\n", agg_table_name[i]);
+                print_entry(i, &table[slot]);
+                differences++;
+            }
+        }
+    }
+
+    printf("Reconciled %lld orders, %lld rows: %d difference(s).\n", (long long)full.orders,
+           (long long)full.rows, differences);
+    if (full.total_mismatch > 0) {
+        printf("Warning: %lld order(s) have ORD.TOTAL different from the sum of ITEM.ITEMTOT.\n",
+               (long long)full.total_mismatch);
+    }
+    return differences;
+}
+
+static void usage() {
+    printf("Usage:\n");
+    printf("  salesagg apply     <store> <orders.csv>\n");
+    printf("  salesagg watermark <store>\n");
+    printf("  salesagg query     <store> customer|product|day <key>\n");
+    printf("  salesagg report    <store> customer|product|day\n");
+    printf("  salesagg snapshot  <store> <snapshot file>\n");
+    printf("  salesagg reconcile <store> <orders.csv>\n");
+}
+
+int main(int argc, char *argv[]) {
+    agg_store_t store;
+    int status = -1;
+
+    if (argc < 3) {
+        usage();
+        return status;
+    }
+    const char *command = argv[1];
+    size_t size;
+    if (strcmp(command, "watermark") == 0 && argc == 3 && !file_size(argv[2], &size)) {
+        printf("0\n");                 // No store yet, export every order
+        return 0;
+    }
+    if (!open_store(&store, argv[2], strcmp(command, "apply") == 0)) {
+        return status;
+    }
+
+    if (strcmp(command, "apply") == 0 && argc == 4) {
+        agg_batch_t batch;
+        std::unordered_set<int64_t> applied;
+        applied_ordids(&store, applied);
+        if (load_orders(argv[3], store_header(&store)->watermark_ordid, &applied, &batch) && apply_batch(&store, &batch)) {
+            printf("Applied %lld orders, %lld rows from %s. Skipped %lld rows already applied. Watermark ORDID %lld\n",
+                   (long long)batch.orders, (long long)batch.rows, argv[3], (long long)batch.skipped,
+                   (long long)store_header(&store)->watermark_ordid);
+            if (store_header(&store)->pending_count > 0) {
+                printf("%u ORDID(s) above the watermark are pending, up to ORDID %lld\n",
+                       store_header(&store)->pending_count, (long long)store_header(&store)->max_ordid);
+            }
+            if (batch.total_mismatch > 0) {
+                printf("Warning: %lld order(s) have ORD.TOTAL different from the sum of ITEM.ITEMTOT.\n",
+                       (long long)batch.total_mismatch);
+            }
+            status = 0;
+        }
+    } else if (strcmp(command, "watermark") == 0 && argc == 3) {
+        printf("%lld\n", (long long)store_header(&store)->watermark_ordid);
+        status = 0;
+    } else if (strcmp(command, "query") == 0 && argc == 5) {
+        int table = table_from_name(argv[3]);
+        int32_t key = 0;
+        if (table == AGG_DAY && !parse_date(argv[4], &key)) {
+            printf("Error: Day %s invalid, format must be DD/MM/YYYY\n", argv[4]);
+            table = -1;
+        } else if (table >= 0 && table != AGG_DAY) {
+            key = atoi(argv[4]);
+        }
+        if (table >= 0) {
+            const agg_entry_t *entry = lookup(&store, table, key);
+            if (entry) {
+                print_heading(table);
+                print_entry(table, entry);
+                status = 0;
+            } else {
+                printf("No sales found for %s %s\n", argv[3], argv[4]);
+                status = 1;
+            }
+        }
+    } else if (strcmp(command, "report") == 0 && argc == 4) {
+        int table = table_from_name(argv[3]);
+        if (table >= 0) {
+            agg_entry_t *entries = store_table(&store, table);
+            std::vector<agg_entry_t> rows;
+            for (uint32_t slot = 0; slot < store_header(&store)->capacity[table]; slot++) {
+                if (entries[slot].used) rows.push_back(entries[slot]);
+            }
+            qsort(rows.data(), rows.size(), sizeof(agg_entry_t), [](const void *a, const void *b) {
+                int32_t ka = ((const agg_entry_t *)a)->key, kb = ((const agg_entry_t *)b)->key;
+                return (ka > kb) - (ka < kb);
+            });
+            print_heading(table);
+            for (size_t i = 0; i < rows.size(); i++) {
+                print_entry(table, &rows[i]);
+            }
+            status = 0;
+        }
+    } else if (strcmp(command, "snapshot") == 0 && argc == 4) {
+        if (snapshot_store(&store, argv[3])) {
+            printf("Snapshot written to %s\n", argv[3]);
+            status = 0;
+        }
+    } else if (strcmp(command, "reconcile") == 0 && argc == 4) {
+        int differences = reconcile(&store, argv[3]);
+        status = differences == 0 ? 0 : 1;
+    } else {
+        usage();
+    }
+
+    close_store(&store);
+    return status;
+}
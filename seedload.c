@@ -0,0 +1,1112 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <ctype.h>
+#include <sys/stat.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <map>
+#include <regex>
+#include <algorithm>
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>        // For GetProcessMemoryInfo()
+#include <direct.h>       // For _mkdir()
+#else
+#include <sys/resource.h> // For getrusage()
+#endif
+
+/*
+  Program Name   : seedload.c
+  Description    : Bulk seed data loader
+  Copyright      : Bond & Pollard Ltd 2025
+  Auther         : agent
+  Date           : 18 October 2026
+
+
+  Converts seed data scripts such as seed_data.sql, which insert one row per
+  INSERT statement, into bulk loads that SQL*Plus runs in a few calls.
+
+  The scripts are read and the rows grouped by table. Column names, types and
+  foreign keys are read from install_schema.sql, and the tables are loaded
+  parents first, e.g. CUSTOMER, PRODUCT, PRICE, ORD, ITEM.
+
+  -mode direct  Writes a SQL*Loader control file and data file for each table,
+                loaded with DIRECT=TRUE. A table with a BEFORE INSERT trigger that
+                fills in its key is loaded by the conventional path if any row
+                leaves the key NULL, because the direct path does not fire triggers.
+  -mode array   Writes a script for each table of multi-row INSERT ALL statements,
+                -batch rows per statement. Tables with a LONG column are inserted
+                a batch at a time in a PL/SQL block, as INSERT ALL cannot be used.
+
+  Both modes write seed_load.sql in the -out directory. It takes the same
+  parameters as seed_data.sql, loads the tables in order, and checks each table
+  has exactly the number of rows in the seed scripts. It exits SQL*Plus with a
+  failure status on any error. In direct mode sqlldr reads the userid from a
+  parameter file, so the password is not on its command line. The file is
+  written just before each sqlldr run and deleted as soon as it ends. A load
+  fails if sqlldr returns an error status or writes a .bad file.
+
+  Only INSERT INTO table [(columns)] VALUES (literals) statements and SQL*Plus
+  commands such as SET, DEFINE, PROMPT and CONNECT can be converted. Anything else
+  is reported as an error, and the seed scripts should be run as they are.
+
+  setup runs seedload when it creates auto_install.sql, and uses seed_load.sql
+  in place of seed_data.sql if the conversion succeeds.
+
+  -convert-bench rows generates a seed script of that many CUSTOMER, PRODUCT,
+  PRICE, ORD and ITEM rows in the -out directory, converts it, and reports the
+  conversion time, rows converted/sec, the number of statements SQL*Plus would
+  run, and peak memory. With -load owner/password@dbconnect it also runs each
+  seed_load.sql in SQL*Plus and reports the load time and rows loaded/sec. The
+  five tables in that schema must be empty, e.g. a scratch schema created with
+  install_schema.sql. The rows are deleted again after each load. The userid is
+  passed to SQL*Plus on its standard input, not its command line.
+
+  Usage: seedload [-mode direct|array] [-schema install_schema.sql] [-out dir]
+                  [-batch n] script.sql...
+         seedload -convert-bench rows [-mode direct|array] [-schema install_schema.sql] [-out dir]
+                  [-load owner/password@dbconnect]
+
+  Build: g++ -O2 -o seedload.exe seedload.c -lpsapi
+
+ */
+
+
+#ifdef _WIN32
+#define DIR_DELIMITER "\\"
+#else
+#define DIR_DELIMITER "/"
+#endif
+
+#define MAX_LINE        65536
+#define DEFAULT_BATCH   100
+#define LONG_LENGTH     32767    // Longest value SQL*Loader reads for a LONG column
+
+typedef struct {
+    std::string name;            // Upper case
+    std::string type;            // NUMBER, VARCHAR2, DATE, LONG...
+    int         length;          // Declared length of character columns, 0 if none
+} column_def_t;
+
+typedef struct {
+    std::string                 name;
+    std::vector<column_def_t>   columns;
+    std::vector<std::string>    parents;        // Tables referenced by foreign keys
+    std::string                 trigger_key;    // Column a BEFORE INSERT trigger fills in when NULL
+    bool                        has_long;
+} table_def_t;
+
+typedef std::map<std::string, table_def_t> schema_t;
+
+// A value from the VALUES list
+typedef struct {
+    std::string text;
+    bool        is_null;
+    bool        is_string;
+} seed_value_t;
+
+// Rows found for one table, and the file they are written to
+typedef struct {
+    table_def_t        *def;
+    int64_t             rows;
+    size_t              first_seen;     // Order tables appear in the scripts
+    std::vector<bool>   used;           // Columns given a value by any row
+    bool                key_missing;    // A row leaves the trigger key NULL
+    FILE               *file;
+    int                 batch_rows;     // Rows in the open INSERT ALL or PL/SQL block
+    int64_t             statements;     // Statements written to the table script
+} table_load_t;
+
+typedef struct {
+    bool                        direct;
+    int                         batch;
+    const char                 *schema_file;
+    const char                 *out_dir;
+    std::vector<const char *>   scripts;
+    const char                 *load_userid;    // owner/password@dbconnect to time the benchmark load, or NULL
+} seed_options_t;
+
+typedef struct {
+    int64_t     rows;
+    int64_t     statements_in;          // INSERT statements in the seed scripts
+    int64_t     statements_out;         // Statements or sqlldr runs in the bulk load
+    int64_t     bytes_in;
+    double      seconds;
+} seed_result_t;
+
+
+static std::string upper(const std::string &text) {
+    std::string result(text);
+    for (size_t i = 0; i < result.size(); i++) result[i] = (char)toupper((unsigned char)result[i]);
+    return result;
+}
+
+static std::string lower(const std::string &text) {
+    std::string result(text);
+    for (size_t i = 0; i < result.size(); i++) result[i] = (char)tolower((unsigned char)result[i]);
+    return result;
+}
+
+static std::string trim(const std::string &text) {
+    size_t start = text.find_first_not_of(" \t\r\n");
+    if (start == std::string::npos) return std::string();
+    size_t end = text.find_last_not_of(" \t\r\n");
+    return text.substr(start, end - start + 1);
+}
+
+static double peak_memory_mb() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize / (1024.0 * 1024.0);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0;    // Kilobytes on Linux
+#endif
+}
+
+static bool make_directory(const char *path) {
+    struct stat info;
+    if (stat(path, &info) == 0) {
+        return (info.st_mode & S_IFDIR) != 0;
+    }
+#ifdef _WIN32
+    return _mkdir(path) == 0;
+#else
+    return mkdir(path, 0755) == 0;
+#endif
+}
+
+static std::string full_path(const char *path) {
+    char buffer[4096];
+#ifdef _WIN32
+    if (_fullpath(buffer, path, sizeof(buffer))) return buffer;
+#else
+    if (realpath(path, buffer)) return buffer;
+#endif
+    return path;
+}
+
+static std::string make_path(const std::string &directory, const std::string &filename) {
+    return directory + DIR_DELIMITER + filename;
+}
+
+// Directory part of a file name, "." if there is none
+static std::string directory_of(const char *filename) {
+    std::string name(filename);
+    size_t pos = name.find_last_of("\\/");
+    return pos == std::string::npos ? std::string(".") : name.substr(0, pos);
+}
+
+// Escape a path for a SQL*Plus script run with SET ESCAPE ON, as setup does for sql_app_home
+static std::string sqlplus_path(const std::string &path) {
+    std::string result;
+    for (size_t i = 0; i < path.size(); i++) {
+        if (path[i] == '\\' || path[i] == '&') result += '\\';
+        result += path[i];
+    }
+    return result;
+}
+
+// Remove /* */ and -- comments, leaving quoted strings alone
+static std::string strip_comments(const std::string &text) {
+    std::string result;
+    result.reserve(text.size());
+    for (size_t i = 0; i < text.size(); i++) {
+        if (text[i] == '\'') {
+            size_t end = text.find('\'', i + 1);
+            if (end == std::string::npos) end = text.size() - 1;
+            result.append(text, i, end - i + 1);
+            i = end;
+        } else if (text.compare(i, 2, "/*") == 0) {
+            size_t end = text.find("*/", i + 2);
+            i = end == std::string::npos ? text.size() : end + 1;
+            result += ' ';
+        } else if (text.compare(i, 2, "--") == 0) {
+            size_t end = text.find('\n', i);
+            i = end == std::string::npos ? text.size() : end - 1;
+        } else {
+            result += text[i];
+        }
+    }
+    return result;
+}
+
+// Split on commas that are not inside brackets
+static std::vector<std::string> split_top_level(const std::string &text) {
+    std::vector<std::string> parts;
+    std::string part;
+    int depth = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+        char c = text[i];
+        if (c == '(') depth++;
+        if (c == ')') depth--;
+        if (c == ',' && depth == 0) {
+            parts.push_back(trim(part));
+            part.clear();
+        } else {
+            part += c;
+        }
+    }
+    if (!trim(part).empty()) parts.push_back(trim(part));
+    return parts;
+}
+
+// Read the tables, foreign keys and key triggers from install_schema.sql
+static bool load_schema(const char *filename, schema_t *schema) {
+    FILE *file = fopen(filename, "rb");
+    if (!file) {
+        printf("Error: Could not open schema script %s\n", filename);
+        return false;
+    }
+    std::string text;
+    char buffer[MAX_LINE];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) text.append(buffer, n);
+    fclose(file);
+    text = strip_comments(text);
+
+    static const std::regex create_table("^CREATE TABLE (IF NOT EXISTS )?(\\w+) ?\\((.*)\\)");
+    static const std::regex foreign_key("^ALTER TABLE (\\w+) ADD CONSTRAINT \\w+ FOREIGN KEY ?\\([^)]*\\) ?REFERENCES (\\w+)");
+    static const std::regex references("REFERENCES (\\w+)");
+    static const std::regex trigger("BEFORE INSERT ON (\\w+).*:NEW\\.(\\w+) IS NULL");
+    std::smatch match;
+
+    // Statements end with a semicolon outside quotes. Whitespace is reduced to single spaces.
+    std::string statement;
+    bool quoted = false;
+    for (size_t i = 0; i <= text.size(); i++) {
+        char c = i < text.size() ? text[i] : ';';
+        if (c == '\'') quoted = !quoted;
+        if (c != ';' || quoted) {
+            if (isspace((unsigned char)c)) {
+                if (!statement.empty() && statement[statement.size() - 1] != ' ') statement += ' ';
+            } else {
+                statement += c;
+            }
+            continue;
+        }
+        std::string sql = upper(trim(statement));
+        statement.clear();
+
+        if (std::regex_search(sql, match, create_table)) {
+            table_def_t def;
+            def.name = match[2];
+            def.has_long = false;
+            std::vector<std::string> items = split_top_level(match[3]);
+            for (size_t c = 0; c < items.size(); c++) {
+                std::string item = items[c];
+                std::string word = item.substr(0, item.find(' '));
+                if (word == "CONSTRAINT" || word == "PRIMARY" || word == "FOREIGN" || word == "UNIQUE" || word == "CHECK") {
+                    if (std::regex_search(item, match, references)) def.parents.push_back(match[1]);
+                    continue;
+                }
+                column_def_t column;
+                std::string type = trim(item.substr(word.size()));
+                column.name = word;
+                column.type = type.substr(0, type.find_first_of(" ("));
+                column.length = 0;
+                if (type.size() > column.type.size() && type[column.type.size()] == '(') {
+                    column.length = atoi(type.c_str() + column.type.size() + 1);
+                }
+                if (column.type == "LONG") def.has_long = true;
+                if (std::regex_search(item, match, references)) def.parents.push_back(match[1]);
+                def.columns.push_back(column);
+            }
+            (*schema)[def.name] = def;
+        } else if (std::regex_search(sql, match, foreign_key)) {
+            schema_t::iterator it = schema->find(match[1]);
+            if (it != schema->end()) it->second.parents.push_back(match[2]);
+        } else if (std::regex_search(sql, match, trigger)) {
+            schema_t::iterator it = schema->find(match[1]);
+            if (it != schema->end()) it->second.trigger_key = match[2];
+        }
+    }
+    if (schema->empty()) {
+        printf("Error: No CREATE TABLE statements found in %s\n", filename);
+        return false;
+    }
+    return true;
+}
+
+static int column_index(const table_def_t *def, const std::string &name) {
+    for (size_t i = 0; i < def->columns.size(); i++) {
+        if (def->columns[i].name == name) return (int)i;
+    }
+    return -1;
+}
+
+static void skip_space(const std::string &sql, size_t *pos) {
+    while (*pos < sql.size() && isspace((unsigned char)sql[*pos])) (*pos)++;
+}
+
+// Match a keyword, ignoring case
+static bool expect_word(const std::string &sql, size_t *pos, const char *word) {
+    skip_space(sql, pos);
+    size_t length = strlen(word);
+    if (sql.size() - *pos < length) return false;
+    for (size_t i = 0; i < length; i++) {
+        if (toupper((unsigned char)sql[*pos + i]) != word[i]) return false;
+    }
+    if (*pos + length < sql.size() && (isalnum((unsigned char)sql[*pos + length]) || sql[*pos + length] == '_')) {
+        return false;
+    }
+    *pos += length;
+    return true;
+}
+
+static std::string read_name(const std::string &sql, size_t *pos) {
+    skip_space(sql, pos);
+    size_t start = *pos;
+    while (*pos < sql.size() && (isalnum((unsigned char)sql[*pos]) || sql[*pos] == '_' || sql[*pos] == '$'
+           || sql[*pos] == '#' || sql[*pos] == '.')) {
+        (*pos)++;
+    }
+    std::string name = upper(sql.substr(start, *pos - start));
+    size_t dot = name.rfind('.');
+    return dot == std::string::npos ? name : name.substr(dot + 1);   // Drop any schema prefix
+}
+
+static bool is_number(const std::string &text) {
+    static const std::regex number("^[+-]?([0-9]+(\\.[0-9]*)?|\\.[0-9]+)([eE][+-]?[0-9]+)?$");
+    return std::regex_match(text, number);
+}
+
+// Read a literal: 'text' with quotes doubled, a number, or NULL
+static bool read_value(const std::string &sql, size_t *pos, seed_value_t *value) {
+    skip_space(sql, pos);
+    value->text.clear();
+    value->is_null = false;
+    value->is_string = false;
+    if (*pos < sql.size() && sql[*pos] == '\'') {
+        value->is_string = true;
+        for ((*pos)++; *pos < sql.size(); (*pos)++) {
+            if (sql[*pos] == '\'') {
+                if (*pos + 1 < sql.size() && sql[*pos + 1] == '\'') {
+                    value->text += '\'';
+                    (*pos)++;
+                } else {
+                    (*pos)++;
+                    value->is_null = value->text.empty();    // '' is NULL in Oracle
+                    return true;
+                }
+            } else {
+                value->text += sql[*pos];
+            }
+        }
+        return false;
+    }
+    size_t start = *pos;
+    while (*pos < sql.size() && sql[*pos] != ',' && sql[*pos] != ')') (*pos)++;
+    value->text = trim(sql.substr(start, *pos - start));
+    if (upper(value->text) == "NULL") {
+        value->is_null = true;
+        return true;
+    }
+    return is_number(value->text);
+}
+
+// Parse INSERT INTO table [(columns)] VALUES (values). Returns an error message, empty if the statement is valid.
+static std::string parse_insert(const std::string &sql, schema_t *schema, table_def_t **def,
+                                std::vector<int> &columns, std::vector<seed_value_t> &values) {
+    size_t pos = 0;
+    columns.clear();
+    values.clear();
+    if (!expect_word(sql, &pos, "INSERT") || !expect_word(sql, &pos, "INTO")) {
+        return "Only INSERT statements can be converted";
+    }
+    std::string table = read_name(sql, &pos);
+    schema_t::iterator it = schema->find(table);
+    if (it == schema->end()) {
+        return "Table " + table + " is not in the schema";
+    }
+    *def = &it->second;
+
+    skip_space(sql, &pos);
+    if (pos < sql.size() && sql[pos] == '(') {
+        do {
+            pos++;
+            std::string name = read_name(sql, &pos);
+            int index = column_index(*def, name);
+            if (index < 0) return "Column " + name + " is not in table " + table;
+            columns.push_back(index);
+            skip_space(sql, &pos);
+        } while (pos < sql.size() && sql[pos] == ',');
+        if (pos >= sql.size() || sql[pos] != ')') return "Column list not closed";
+        pos++;
+    } else {
+        for (size_t i = 0; i < (*def)->columns.size(); i++) columns.push_back((int)i);
+    }
+
+    if (!expect_word(sql, &pos, "VALUES")) return "Only INSERT ... VALUES statements can be converted";
+    skip_space(sql, &pos);
+    if (pos >= sql.size() || sql[pos] != '(') return "VALUES list not found";
+    do {
+        pos++;
+        seed_value_t value;
+        if (!read_value(sql, &pos, &value)) {
+            return "Value " + value.text + " is not a literal";
+        }
+        if (value.text.find('&') != std::string::npos) {
+            return "Value " + value.text + " contains a substitution variable";
+        }
+        values.push_back(value);
+        skip_space(sql, &pos);
+    } while (pos < sql.size() && sql[pos] == ',');
+    if (pos >= sql.size() || sql[pos] != ')') return "VALUES list not closed";
+    pos++;
+    skip_space(sql, &pos);
+    if (pos != sql.size()) return "Unexpected text after VALUES list";
+    if (values.size() != columns.size()) return "Number of values does not match the number of columns";
+    return std::string();
+}
+
+// Write a value as a SQL literal
+static void write_literal(FILE *file, const seed_value_t &value) {
+    if (value.is_null) {
+        fputs("NULL", file);
+    } else if (!value.is_string) {
+        fputs(value.text.c_str(), file);
+    } else {
+        fputc('\'', file);
+        for (size_t i = 0; i < value.text.size(); i++) {
+            if (value.text[i] == '\'') fputc('\'', file);
+            fputc(value.text[i], file);
+        }
+        fputc('\'', file);
+    }
+}
+
+static void end_batch(table_load_t *load) {
+    if (load->batch_rows == 0) return;
+    if (load->def->has_long) {
+        fputs("END;\n/\n", load->file);
+    } else {
+        fputs("SELECT * FROM dual;\n", load->file);
+    }
+    load->batch_rows = 0;
+}
+
+static void write_array_row(table_load_t *load, const std::vector<int> &columns, const std::vector<seed_value_t> &values,
+                            int batch) {
+    FILE *file = load->file;
+    if (load->batch_rows == 0) {
+        fputs(load->def->has_long ? "BEGIN\n" : "INSERT ALL\n", file);
+        load->statements++;
+    }
+    fprintf(file, load->def->has_long ? "  INSERT INTO %s (" : "  INTO %s (", lower(load->def->name).c_str());
+    for (size_t i = 0; i < columns.size(); i++) {
+        fprintf(file, "%s%s", i ? ", " : "", load->def->columns[columns[i]].name.c_str());
+    }
+    fputs(") VALUES (", file);
+    for (size_t i = 0; i < values.size(); i++) {
+        if (i) fputs(", ", file);
+        write_literal(file, values[i]);
+    }
+    fputs(load->def->has_long ? ");\n" : ")\n", file);
+    if (++load->batch_rows >= batch) end_batch(load);
+}
+
+// Write a row to the data file, one field for every column in the table
+static bool write_data_row(table_load_t *load, const std::vector<int> &columns, const std::vector<seed_value_t> &values) {
+    static std::vector<const seed_value_t *> row;
+    row.assign(load->def->columns.size(), NULL);
+    for (size_t i = 0; i < columns.size(); i++) row[columns[i]] = &values[i];
+    for (size_t c = 0; c < row.size(); c++) {
+        if (c) fputc(',', load->file);
+        const seed_value_t *value = row[c];
+        if (!value || value->is_null) continue;
+        if (value->text.find_first_of("\r\n") != std::string::npos) {
+            return false;
+        }
+        if (!value->is_string) {
+            fputs(value->text.c_str(), load->file);
+            continue;
+        }
+        fputc('"', load->file);
+        for (size_t i = 0; i < value->text.size(); i++) {
+            if (value->text[i] == '"') fputc('"', load->file);
+            fputc(value->text[i], load->file);
+        }
+        fputc('"', load->file);
+    }
+    fputc('\n', load->file);
+    return true;
+}
+
+// Write a row to the file for its table. Returns an error message, empty if the row was written.
+static std::string add_row(std::map<std::string, table_load_t> *loads, const seed_options_t *options, table_def_t *def,
+                           const std::vector<int> &columns, const std::vector<seed_value_t> &values) {
+    std::map<std::string, table_load_t>::iterator it = loads->find(def->name);
+    if (it == loads->end()) {
+        table_load_t load;
+        load.def = def;
+        load.rows = 0;
+        load.first_seen = loads->size();
+        load.used.assign(def->columns.size(), false);
+        load.key_missing = false;
+        load.batch_rows = 0;
+        load.statements = 0;
+        std::string filename = make_path(options->out_dir, lower(def->name) + (options->direct ? ".dat" : ".sql"));
+        load.file = fopen(filename.c_str(), "w");
+        if (!load.file) {
+            return "Cannot open " + filename + " for writing";
+        }
+        setvbuf(load.file, NULL, _IOFBF, 1 << 20);
+        if (!options->direct) {
+            fprintf(load.file, "-- %s rows created by seedload\n", def->name.c_str());
+        }
+        it = loads->insert(std::make_pair(def->name, load)).first;
+    }
+    table_load_t *load = &it->second;
+
+    bool key_given = false;
+    int key = def->trigger_key.empty() ? -1 : column_index(def, def->trigger_key);
+    for (size_t i = 0; i < columns.size(); i++) {
+        if (!values[i].is_null) load->used[columns[i]] = true;
+        if (columns[i] == key && !values[i].is_null) key_given = true;
+    }
+    if (key >= 0 && !key_given) load->key_missing = true;
+    load->rows++;
+
+    if (options->direct) {
+        if (!write_data_row(load, columns, values)) {
+            return "Values containing line breaks cannot be loaded with -mode direct";
+        }
+    } else {
+        write_array_row(load, columns, values, options->batch);
+    }
+    return std::string();
+}
+
+static bool is_sqlplus_command(const std::string &line) {
+    static const char *commands[] = { "SET", "DEFINE", "UNDEFINE", "PROMPT", "CONNECT", "CONN", "REM", "REMARK",
+        "SPOOL", "WHENEVER", "EXIT", "QUIT", "COLUMN", "TTITLE", "BTITLE", "PAUSE", "ACCEPT", "SHOW", "START", NULL };
+    std::string text = trim(line);
+    if (text.empty()) return false;
+    if (text[0] == '@') return true;
+    std::string word = upper(text.substr(0, text.find_first_of(" \t")));
+    for (int i = 0; commands[i]; i++) {
+        if (word == commands[i]) return true;
+    }
+    return false;
+}
+
+// Read a seed script, passing each row to add_row
+static bool read_script(const char *filename, schema_t *schema, const seed_options_t *options,
+                        std::map<std::string, table_load_t> *loads, seed_result_t *result) {
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        printf("Error: Could not open seed script %s\n", filename);
+        return false;
+    }
+    setvbuf(file, NULL, _IOFBF, 1 << 20);
+    char line[MAX_LINE];
+    std::string statement;
+    bool in_comment = false, quoted = false;
+    int line_no = 0, statement_line = 0;
+    std::vector<int> columns;
+    std::vector<seed_value_t> values;
+    bool ok = true;
+
+    while (ok && fgets(line, sizeof(line), file)) {
+        line_no++;
+        result->bytes_in += (int64_t)strlen(line);
+        if (statement.empty() && !in_comment) {
+            if (is_sqlplus_command(line)) continue;
+            if (trim(line) == "/") continue;
+        }
+        for (const char *p = line; *p && ok; p++) {
+            if (in_comment) {
+                if (p[0] == '*' && p[1] == '/') {
+                    in_comment = false;
+                    p++;
+                }
+            } else if (quoted) {
+                statement += *p;
+                if (*p == '\'') quoted = false;     // A doubled quote closes and reopens
+            } else if (p[0] == '/' && p[1] == '*') {
+                in_comment = true;
+                p++;
+            } else if (p[0] == '-' && p[1] == '-') {
+                break;
+            } else if (*p == '\'') {
+                statement += *p;
+                quoted = true;
+            } else if (*p == ';') {
+                std::string sql = trim(statement);
+                statement.clear();
+                if (sql.empty() || upper(sql) == "COMMIT") continue;
+                table_def_t *def = NULL;
+                std::string error = parse_insert(sql, schema, &def, columns, values);
+                if (error.empty()) {
+                    error = add_row(loads, options, def, columns, values);
+                }
+                if (!error.empty()) {
+                    printf("Error: %s line %d: %s\n", filename, statement_line, error.c_str());
+                    ok = false;
+                }
+                result->statements_in++;
+                result->rows++;
+            } else {
+                if (statement.empty()) {
+                    if (isspace((unsigned char)*p)) continue;
+                    statement_line = line_no;
+                }
+                statement += *p;
+            }
+        }
+    }
+    fclose(file);
+    if (ok && !trim(statement).empty()) {
+        printf("Error: %s line %d: Statement has no closing semicolon\n", filename, statement_line);
+        ok = false;
+    }
+    return ok;
+}
+
+// Order the tables so each is loaded after the tables its foreign keys refer to
+static bool load_order(std::map<std::string, table_load_t> *loads, std::vector<table_load_t *> &order) {
+    std::vector<table_load_t *> pending;
+    for (std::map<std::string, table_load_t>::iterator it = loads->begin(); it != loads->end(); ++it) {
+        pending.push_back(&it->second);
+    }
+    std::sort(pending.begin(), pending.end(),
+              [](const table_load_t *a, const table_load_t *b) { return a->first_seen < b->first_seen; });
+    order.clear();
+    while (!pending.empty()) {
+        size_t next = 0;
+        for (; next < pending.size(); next++) {
+            bool ready = true;
+            const std::vector<std::string> &parents = pending[next]->def->parents;
+            for (size_t p = 0; p < parents.size() && ready; p++) {
+                if (parents[p] == pending[next]->def->name) continue;    // Self reference, e.g. EMP.MGR
+                for (size_t q = 0; q < pending.size() && ready; q++) {
+                    ready = pending[q]->def->name != parents[p];
+                }
+            }
+            if (ready) break;
+        }
+        if (next == pending.size()) {
+            printf("Error: Foreign keys between %s and other tables form a cycle\n", pending[0]->def->name.c_str());
+            return false;
+        }
+        order.push_back(pending[next]);
+        pending.erase(pending.begin() + next);
+    }
+    return true;
+}
+
+static bool write_control_file(const seed_options_t *options, table_load_t *load) {
+    std::string filename = make_path(options->out_dir, lower(load->def->name) + ".ctl");
+    FILE *file = fopen(filename.c_str(), "w");
+    if (!file) {
+        printf("Error: Cannot open %s for writing!\n", filename.c_str());
+        return false;
+    }
+    bool direct = !load->key_missing;
+    fprintf(file, "-- %s rows created by seedload. Data file %s.dat\n", load->def->name.c_str(), lower(load->def->name).c_str());
+    if (!direct) {
+        fprintf(file, "-- Conventional path so that trigger on %s fills in %s\n", load->def->name.c_str(),
+                load->def->trigger_key.c_str());
+    }
+    fprintf(file, "OPTIONS (DIRECT=%s, ERRORS=0)\n", direct ? "TRUE" : "FALSE");
+    fprintf(file, "LOAD DATA\n");
+    fprintf(file, "APPEND\n");
+    fprintf(file, "INTO TABLE %s\n", lower(load->def->name).c_str());
+    if (direct) {
+        fprintf(file, "REENABLE DISABLED_CONSTRAINTS\n");
+    }
+    fprintf(file, "FIELDS TERMINATED BY ',' OPTIONALLY ENCLOSED BY '\"'\n");
+    fprintf(file, "TRAILING NULLCOLS\n");
+    fprintf(file, "(\n");
+    for (size_t c = 0; c < load->def->columns.size(); c++) {
+        const column_def_t &column = load->def->columns[c];
+        const char *end = c + 1 < load->def->columns.size() ? "," : "";
+        if (!load->used[c]) {
+            fprintf(file, "  %-20s FILLER%s\n", column.name.c_str(), end);
+        } else if (column.type == "DATE") {
+            fprintf(file, "  %-20s DATE \"DD-MON-RR\"%s\n", column.name.c_str(), end);
+        } else if (column.type == "LONG") {
+            fprintf(file, "  %-20s CHAR(%d)%s\n", column.name.c_str(), LONG_LENGTH, end);
+        } else if (column.length > 255 && column.type != "NUMBER") {
+            fprintf(file, "  %-20s CHAR(%d)%s\n", column.name.c_str(), column.length, end);
+        } else {
+            fprintf(file, "  %s%s\n", column.name.c_str(), end);
+        }
+    }
+    fprintf(file, ")\n");
+    return fclose(file) == 0;
+}
+
+// Write seed_load.sql, which loads the tables in order and checks the row counts
+static bool write_load_script(const seed_options_t *options, std::vector<table_load_t *> &order, seed_result_t *result) {
+    std::string filename = make_path(options->out_dir, "seed_load.sql");
+    std::string out_dir = sqlplus_path(full_path(options->out_dir));
+    FILE *file = fopen(filename.c_str(), "w");
+    if (!file) {
+        printf("Error: Cannot open %s for writing!\n", filename.c_str());
+        return false;
+    }
+    fprintf(file, "/* NAME:    seed_load.sql\n");
+    fprintf(file, "   DESCRIPTION\n");
+    fprintf(file, "            Created by seedload from:\n");
+    for (size_t i = 0; i < options->scripts.size(); i++) {
+        fprintf(file, "              %s\n", options->scripts[i]);
+    }
+    fprintf(file, "            Loads the seed data %s, parent tables first.\n",
+            options->direct ? "with SQL*Loader" : "with multi-row inserts");
+    fprintf(file, "            Run with the same parameters as seed_data.sql.\n");
+    fprintf(file, "*/\n\n");
+    fprintf(file, "  SET TERMOUT ON\n");
+    fprintf(file, "  SET ECHO OFF\n");
+    fprintf(file, "  SET ESCAPE ON\n\n");
+    fprintf(file, "  DEFINE v_dbservice = \"&1\"\n");
+    fprintf(file, "  DEFINE v_dbconnect = \"&2\"\n");
+    fprintf(file, "  DEFINE v_app_owner = \"&3\"\n");
+    fprintf(file, "  DEFINE v_password  = \"&4\"\n\n");
+    fprintf(file, "  WHENEVER SQLERROR EXIT FAILURE\n\n");
+    fprintf(file, "  PROMPT Load data into &v_app_owner in database &v_dbservice\n\n");
+    fprintf(file, "  CONNECT &v_app_owner/&v_password@&v_dbconnect\n\n");
+    if (options->direct) {
+        fprintf(file, "  SET VERIFY OFF\n");
+        fprintf(file, "  SET FEEDBACK OFF\n");
+        fprintf(file, "  SET TRIMSPOOL ON\n\n");
+    }
+
+    result->statements_out = 0;
+    for (size_t i = 0; i < order.size(); i++) {
+        table_load_t *load = order[i];
+        std::string table = lower(load->def->name);
+        fprintf(file, "  PROMPT Load %lld rows into %s\n", (long long)load->rows, load->def->name.c_str());
+        if (options->direct) {
+            // SQL*Plus HOST does not return the exit status, so cmd writes it to <table>_status.sql:
+            // 0 loaded, 1 sqlldr failed, 2 rows rejected to the .bad file
+            // The parameter file keeps the password off the sqlldr command line. It is written just
+            // before sqlldr runs and the same command deletes it, whatever sqlldr returns.
+            std::string path = out_dir + "\\\\" + table;
+            fprintf(file, "  HOST DEL /Q \"%s.bad\" \"%s_status.sql\" 2>NUL\n", path.c_str(), path.c_str());
+            fprintf(file, "  SET TERMOUT OFF\n");
+            fprintf(file, "  SPOOL \"%s\\\\sqlldr.par\"\n", out_dir.c_str());
+            fprintf(file, "  PROMPT userid=&v_app_owner/&v_password@&v_dbconnect\n");
+            fprintf(file, "  SPOOL OFF\n");
+            fprintf(file, "  SET TERMOUT ON\n");
+            fprintf(file, "  HOST sqlldr parfile=\"%s\\\\sqlldr.par\" control=\"%s.ctl\" data=\"%s.dat\" log=\"%s.log\" "
+                          "bad=\"%s.bad\" silent=header,feedback "
+                          "\\&\\& ECHO DEFINE v_%s_status = 0 > \"%s_status.sql\" || ECHO DEFINE v_%s_status = 1 > \"%s_status.sql\" "
+                          "\\& DEL /Q \"%s\\\\sqlldr.par\"\n",
+                    out_dir.c_str(), path.c_str(), path.c_str(), path.c_str(), path.c_str(), table.c_str(), path.c_str(),
+                    table.c_str(), path.c_str(), out_dir.c_str());
+            fprintf(file, "  HOST IF EXIST \"%s.bad\" ECHO DEFINE v_%s_status = 2 > \"%s_status.sql\"\n",
+                    path.c_str(), table.c_str(), path.c_str());
+            fprintf(file, "  @\"%s_status.sql\"\n", path.c_str());
+            result->statements_out++;
+        } else {
+            fprintf(file, "  @@%s\n", table.c_str());
+            result->statements_out += load->statements;
+        }
+    }
+    fprintf(file, "\n  COMMIT;\n\n");
+
+    fprintf(file, "/*\n** Check every row was loaded\n*/\n");
+    fprintf(file, "DECLARE\n");
+    fprintf(file, "  l_count NUMBER;\n");
+    fprintf(file, "BEGIN\n");
+    for (size_t i = 0; i < order.size() && options->direct; i++) {
+        std::string table = lower(order[i]->def->name);
+        fprintf(file, "  IF '&v_%s_status' = '1' THEN\n", table.c_str());
+        fprintf(file, "    raise_application_error (-20099,'SQL*Loader failed loading %s, see %s.log');\n",
+                order[i]->def->name.c_str(), table.c_str());
+        fprintf(file, "  ELSIF '&v_%s_status' <> '0' THEN\n", table.c_str());
+        fprintf(file, "    raise_application_error (-20099,'SQL*Loader rejected rows loading %s, see %s.bad');\n",
+                order[i]->def->name.c_str(), table.c_str());
+        fprintf(file, "  END IF;\n");
+    }
+    for (size_t i = 0; i < order.size(); i++) {
+        table_load_t *load = order[i];
+        fprintf(file, "  SELECT COUNT(*) INTO l_count FROM %s;\n", lower(load->def->name).c_str());
+        fprintf(file, "  IF l_count <> %lld THEN\n", (long long)load->rows);
+        fprintf(file, "    raise_application_error (-20099,'Seed load of %s does not match the seed scripts. Expected %lld rows, found ' || l_count);\n",
+                load->def->name.c_str(), (long long)load->rows);
+        fprintf(file, "  END IF;\n");
+    }
+    fprintf(file, "END;\n/\n\n");
+    fprintf(file, "  WHENEVER SQLERROR CONTINUE\n");
+    return fclose(file) == 0;
+}
+
+static bool convert_seed(const seed_options_t *options, seed_result_t *result) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    schema_t schema;
+    std::map<std::string, table_load_t> loads;
+    std::vector<table_load_t *> order;
+
+    memset(result, 0, sizeof(*result));
+    if (!load_schema(options->schema_file, &schema)) {
+        return false;
+    }
+    if (!make_directory(options->out_dir)) {
+        printf("Error: Could not create directory %s\n", options->out_dir);
+        return false;
+    }
+    bool ok = true;
+    for (size_t i = 0; i < options->scripts.size() && ok; i++) {
+        ok = read_script(options->scripts[i], &schema, options, &loads, result);
+    }
+    for (std::map<std::string, table_load_t>::iterator it = loads.begin(); it != loads.end(); ++it) {
+        end_batch(&it->second);
+        if (fclose(it->second.file) != 0) ok = false;
+    }
+    if (!ok) {
+        return false;
+    }
+    if (loads.empty()) {
+        printf("Error: No INSERT statements found.\n");
+        return false;
+    }
+    ok = load_order(&loads, order);
+    for (size_t i = 0; i < order.size() && ok && options->direct; i++) {
+        ok = write_control_file(options, order[i]);
+    }
+    ok = ok && write_load_script(options, order, result);
+    result->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (ok) {
+        printf("Load order:\n");
+        for (size_t i = 0; i < order.size(); i++) {
+            printf("  %-20s %10lld rows%s\n", order[i]->def->name.c_str(), (long long)order[i]->rows,
+                   options->direct && order[i]->key_missing ? "  (conventional path)" : "");
+        }
+        printf("Script written: %s\n", make_path(options->out_dir, "seed_load.sql").c_str());
+    }
+    return ok;
+}
+
+// Write a seed script in the style of seed_data.sql with the given number of rows
+static bool generate_bench_seed(const char *filename, int64_t rows) {
+    FILE *file = fopen(filename, "w");
+    if (!file) {
+        printf("Error: Cannot open %s for writing!\n", filename);
+        return false;
+    }
+    setvbuf(file, NULL, _IOFBF, 1 << 20);
+    static const char *months[12] = { "JAN", "FEB", "MAR", "APR", "MAY", "JUN", "JUL", "AUG", "SEP", "OCT", "NOV", "DEC" };
+    int64_t customers = std::max<int64_t>(1, rows / 200);
+    int64_t products = std::max<int64_t>(1, rows / 500);
+    int64_t orders = std::max<int64_t>(1, (rows - customers - 2 * products) / 11);
+    int64_t items = std::max<int64_t>(0, rows - customers - 2 * products - orders);
+    int64_t first_ordid = 1000;
+
+    if (first_ordid + orders > 99999) {
+        printf("Warning: %lld orders exceed ORD.ORDID NUMBER(5,0), the seed would not load into Oracle.\n",
+               (long long)orders);
+    }
+    fprintf(file, "/*\n** Benchmark seed data, %lld rows\n*/\n", (long long)rows);
+    fprintf(file, "  SET TERMOUT ON\n  SET ECHO OFF\n\n");
+    for (int64_t c = 0; c < customers; c++) {
+        fprintf(file, "INSERT INTO customer (ZIP, STATE, REPID, PHONE, NAME, CUSTID, CREDITLIMIT, CITY, AREA, ADDRESS, COMMENTS) "
+                      "VALUES ('%05lld', 'CA', '7844', '598-6609', 'CUSTOMER %lld','%lld', '5000', 'BURLINGAME', '415', "
+                      "'%lld O''BRIEN ST.', 'Seed customer');\n",
+                (long long)(10000 + c % 90000), (long long)c, (long long)(200000 + c), (long long)(c % 999 + 1));
+    }
+    for (int64_t p = 0; p < products; p++) {
+        fprintf(file, "INSERT INTO product (prodid, descrip) VALUES ('%lld', 'PRODUCT %lld');\n",
+                (long long)(300000 + p), (long long)p);
+    }
+    for (int64_t p = 0; p < products; p++) {
+        fprintf(file, "INSERT INTO price (stdprice, startdate, prodid, minprice, enddate) "
+                      "VALUES ('%lld.50', '01-JAN-1985', '%lld', '%lld', '');\n",
+                (long long)(p % 500 + 1), (long long)(300000 + p), (long long)(p % 500 + 1));
+    }
+    for (int64_t o = 0; o < orders; o++) {
+        fprintf(file, "INSERT INTO ord (total, shipdate, ordid, orderdate, custid, commplan) "
+                      "VALUES ('%lld', '%02d-%s-1987', '%lld', '%02d-%s-1987', '%lld', '%s');\n",
+                (long long)(o % 1000 * 10), (int)(o % 28 + 1), months[o % 12], (long long)(first_ordid + o),
+                (int)(o % 28 + 1), months[o % 12], (long long)(200000 + o % customers), o % 3 ? "" : "A");
+    }
+    for (int64_t i = 0; i < items; i++) {
+        int64_t o = i % orders;
+        fprintf(file, "INSERT INTO item ( qty , prodid , ordid , itemtot , itemid , actualprice) "
+                      "VALUES ('%lld', '%lld', '%lld', '%lld', '%lld', '3.4');\n",
+                (long long)(i % 100 + 1), (long long)(300000 + i % products), (long long)(first_ordid + o),
+                (long long)((i % 100 + 1) * 34 / 10), (long long)(i / orders + 1));
+    }
+    fprintf(file, "\nCOMMIT;\n");
+    return fclose(file) == 0;
+}
+
+// Tables the benchmark seed loads, children first
+static const char *bench_tables[] = { "item", "ord", "price", "product", "customer" };
+
+// Run commands in SQL*Plus. They are written to its standard input, so the userid is not on a
+// command line. Returns true if SQL*Plus exits with a success status.
+static bool run_sqlplus(const std::string &commands) {
+    fflush(stdout);
+    FILE *sqlplus = popen("sqlplus -s /nolog", "w");
+    if (!sqlplus) {
+        printf("Error: Could not run sqlplus\n");
+        return false;
+    }
+    bool ok = fputs(commands.c_str(), sqlplus) >= 0;
+    return pclose(sqlplus) == 0 && ok;
+}
+
+// Run seed_load.sql for the benchmark seed into the -load schema and time it. The tables must
+// be empty before the load, and the benchmark rows are deleted again afterwards.
+static bool time_bench_load(const seed_options_t *options, double *seconds) {
+    std::string userid = options->load_userid;
+    size_t slash = userid.find('/'), at = userid.rfind('@');
+    if (slash == std::string::npos || at == std::string::npos || at < slash) {
+        printf("Error: -load must be owner/password@dbconnect\n");
+        return false;
+    }
+    std::string owner = userid.substr(0, slash), password = userid.substr(slash + 1, at - slash - 1);
+    std::string dbconnect = userid.substr(at + 1);
+    std::string connect = "WHENEVER SQLERROR EXIT FAILURE\nCONNECT " + userid + "\n";
+
+    std::string check = connect + "DECLARE\n  l_count NUMBER;\nBEGIN\n";
+    std::string clear = connect;
+    for (size_t i = 0; i < sizeof(bench_tables) / sizeof(bench_tables[0]); i++) {
+        check += std::string("  SELECT COUNT(*) INTO l_count FROM ") + bench_tables[i] + ";\n"
+               + "  IF l_count > 0 THEN\n"
+               + "    raise_application_error (-20099,'" + bench_tables[i] + " is not empty, the benchmark needs an empty schema');\n"
+               + "  END IF;\n";
+        clear += std::string("DELETE FROM ") + bench_tables[i] + ";\n";
+    }
+    check += "END;\n/\nEXIT\n";
+    clear += "COMMIT;\nEXIT\n";
+    if (!run_sqlplus(check)) {
+        printf("Error: Could not check the tables in %s are empty, the load was not run.\n", owner.c_str());
+        return false;
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    bool ok = run_sqlplus("@\"" + make_path(full_path(options->out_dir), "seed_load.sql") + "\" " + dbconnect + " "
+                          + dbconnect + " " + owner + " " + password + "\nEXIT\n");
+    *seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (!ok) {
+        printf("Error: seed_load.sql failed.\n");
+    }
+    if (!run_sqlplus(clear)) {
+        printf("Error: Could not delete the benchmark rows from %s.\n", owner.c_str());
+        ok = false;
+    }
+    return ok;
+}
+
+// Time the conversion of a generated seed script, and with -load the load into a database
+static int run_conversion_benchmark(seed_options_t *options, int64_t rows, const char *mode) {
+    std::string script = make_path(options->out_dir, "bench_seed.sql");
+    if (!make_directory(options->out_dir)) {
+        printf("Error: Could not create directory %s\n", options->out_dir);
+        return -1;
+    }
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (!generate_bench_seed(script.c_str(), rows)) {
+        return -1;
+    }
+    double generate_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("Generated %s in %.2f s\n\n", script.c_str(), generate_seconds);
+    options->scripts.clear();
+    options->scripts.push_back(script.c_str());
+
+    for (int m = 0; m < 2; m++) {
+        options->direct = m == 0;
+        if (mode && strcmp(mode, options->direct ? "direct" : "array") != 0) continue;
+        seed_result_t result;
+        printf("Mode %s\n", options->direct ? "direct" : "array");
+        if (!convert_seed(options, &result)) {
+            return -1;
+        }
+        printf("Rows                 : %lld\n", (long long)result.rows);
+        printf("Seed script          : %.1f MB\n", result.bytes_in / (1024.0 * 1024.0));
+        printf("Conversion time      : %.2f s\n", result.seconds);
+        printf("Rows converted/sec   : %.0f\n", result.seconds > 0 ? result.rows / result.seconds : 0);
+        printf("SQL*Plus statements  : %lld before, %lld after (%s)\n", (long long)result.statements_in,
+               (long long)result.statements_out, options->direct ? "sqlldr runs" : "INSERT ALL batches");
+        printf("Peak memory          : %.1f MB\n", peak_memory_mb());
+        if (options->load_userid) {
+            double seconds;
+            if (!time_bench_load(options, &seconds)) {
+                return -1;
+            }
+            printf("Load time            : %.2f s\n", seconds);
+            printf("Rows loaded/sec      : %.0f\n", seconds > 0 ? result.rows / seconds : 0);
+        }
+        printf("\n");
+    }
+    if (!options->load_userid) {
+        printf("Load time is not measured, use -load owner/password@dbconnect to time the load.\n");
+    }
+    return 0;
+}
+
+static void usage() {
+    printf("Usage: seedload [-mode direct|array] [-schema install_schema.sql] [-out dir] [-batch n] script.sql...\n");
+    printf("       seedload -convert-bench rows [-mode direct|array] [-schema install_schema.sql] [-out dir]\n");
+    printf("                [-load owner/password@dbconnect]\n");
+}
+
+int main(int argc, char *argv[]) {
+    seed_options_t options;
+    const char *mode = NULL;
+    int64_t bench_rows = 0;
+    std::string default_schema, default_out;
+    int status = -1;
+
+    options.batch = DEFAULT_BATCH;
+    options.schema_file = NULL;
+    options.out_dir = NULL;
+    options.load_userid = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] == '-' && i + 1 >= argc) {
+            usage();
+            return status;
+        }
+        if (strcmp(argv[i], "-mode") == 0) mode = argv[++i];
+        else if (strcmp(argv[i], "-schema") == 0) options.schema_file = argv[++i];
+        else if (strcmp(argv[i], "-out") == 0) options.out_dir = argv[++i];
+        else if (strcmp(argv[i], "-batch") == 0) options.batch = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-convert-bench") == 0) bench_rows = atoll(argv[++i]);
+        else if (strcmp(argv[i], "-load") == 0) options.load_userid = argv[++i];
+        else if (argv[i][0] == '-') {
+            usage();
+            return status;
+        } else options.scripts.push_back(argv[i]);
+    }
+    if ((mode && strcmp(mode, "direct") != 0 && strcmp(mode, "array") != 0) || options.batch < 1
+        || (bench_rows <= 0 && options.scripts.empty()) || (bench_rows <= 0 && options.load_userid)) {
+        usage();
+        return status;
+    }
+    options.direct = !mode || strcmp(mode, "direct") == 0;
+
+    // By default the schema script is next to the first seed script, and the output goes in a seed directory there
+    std::string home = options.scripts.empty() ? std::string(".") : directory_of(options.scripts[0]);
+    if (!options.schema_file) {
+        default_schema = make_path(home, "install_schema.sql");
+        options.schema_file = default_schema.c_str();
+    }
+    if (!options.out_dir) {
+        default_out = make_path(home, "seed");
+        options.out_dir = default_out.c_str();
+    }
+
+    if (bench_rows > 0) {
+        return run_conversion_benchmark(&options, bench_rows, mode);
+    }
+    seed_result_t result;
+    if (convert_seed(&options, &result)) {
+        printf("%lld rows converted in %.2f s. %lld INSERT statements replaced by %lld %s.\n",
+               (long long)result.rows, result.seconds, (long long)result.statements_in, (long long)result.statements_out,
+               options.direct ? "sqlldr runs" : "batches");
+        status = 0;
+    }
+    return status;
+}
@@ -3,6 +3,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/stat.h>
+#include <time.h>
 #include <windows.h>
 #include <shlwapi.h>      // For PathCombine()
 #include <shlobj.h>       // For SHCreateDirectoryEx()
@@ -31,6 +32,7 @@
   Create the DATA_HOME directory.
   Create set_env.bat
   Create set_env.sql
+  Convert seed_data.sql to a bulk load with seedload.exe, using SQL*Loader if it is installed.
   Create auto_install.sql
   TBC: Create compile_packages - find all pls package files and add to script. Need to compile in correct sequence due to dependencies.
   Execute SQL script auto_install.sql to create db objects, compile packages.
@@ -47,6 +49,12 @@ void log_event(const char *format, ...) {
         return;
     }
 
+    // Prefix each message with the date and time, so the log can be loaded by logq
+    time_t now = time(NULL);
+    char timestamp[24];
+    strftime(timestamp, sizeof(timestamp), "%d/%m/%Y %H:%M:%S", localtime(&now));
+    fprintf(log_file, "%s ", timestamp);
+
     va_list args;
     va_start(args, format);
     vfprintf(log_file, format, args);  // Write formatted message to log file
@@ -474,6 +482,35 @@ void generate_set_env_bat(const char *dbservice,
     printf("Script generated: %s\n", filespec);
 }
 
+// Convert seed_data.sql to SQL*Loader files, or multi-row insert batches if SQL*Loader is not installed.
+// Returns true if install\seed\seed_load.sql was created, otherwise seed_data.sql must be run.
+bool generate_seed_load(const char *app_home) {
+    char seedload[MAX_PATH];
+    char command[MAX_PATH * 4];
+    struct stat info;
+    
+    snprintf(seedload, sizeof(seedload), "%s\\seedload.exe", app_home);
+    if (stat(seedload, &info) != 0) {
+        printf("%s not found, seed data will be loaded by seed_data.sql.\n", seedload);
+        log_event("Warning: %s not found, seed data will be loaded by seed_data.sql.", seedload);
+        return false;
+    }
+    
+    const char *mode = (system("where sqlldr >nul 2>&1") == 0) ? "direct" : "array";
+    // cmd removes the outer quotes, so the whole command is enclosed in another pair
+    snprintf(command, sizeof(command), "\"\"%s\" -mode %s -out \"%s\\install\\seed\" \"%s\\install\\seed_data.sql\"\"",
+             seedload, mode, app_home, app_home);
+    printf("Executing: %s\n", command);
+    log_event("Executing: %s", command);
+    if (system(command) != 0) {
+        printf("Seed data could not be converted, it will be loaded by seed_data.sql.\n");
+        log_event("Warning: Seed data could not be converted, it will be loaded by seed_data.sql.");
+        return false;
+    }
+    log_event("Seed data converted to %s load in %s\\install\\seed.", mode, app_home);
+    return true;
+}
+
 void generate_auto_install_sql(const char *dbservice, 
                            const char *port, 
                            const char *db_connect, 
@@ -483,7 +520,8 @@ void generate_auto_install_sql(const char *dbservice,
                            const char *connect_pwd, 
                            const char *sql_app_home, 
                            const char *sql_data_home,
-                           const char *app_home) {
+                           const char *app_home,
+                           bool fast_seed) {
     char filespec [MAX_PATH];
     snprintf(filespec, sizeof(filespec), "%s%s", app_home, "\\install\\auto_install.sql");
     printf("Creating %s...\n",filespec);
@@ -509,7 +547,11 @@ void generate_auto_install_sql(const char *dbservice,
     fprintf(file, "ACCEPT v_sys_pwd CHAR PROMPT 'Enter SYS password: '\n");
     fprintf(file, "CONNECT SYS/&v_sys_pwd@&v_dbconnect AS SYSDBA\n");
     fprintf(file, "@'&v_app_home\\\\install\\\\install_schema'     \"&v_dbservice\" \"&v_dbconnect\" \"&v_app_owner\" \"&v_pwd\" \"&v_connect_user\" \"&v_connect_pwd\" \"&v_app_home\" \"&v_data_home\" \n");
-    fprintf(file, "@'&v_app_home\\\\install\\\\seed_data'          \"&v_dbservice\" \"&v_dbconnect\" \"&v_app_owner\" \"&v_pwd\"  \n");
+    if (fast_seed) {
+        fprintf(file, "@'&v_app_home\\\\install\\\\seed\\\\seed_load' \"&v_dbservice\" \"&v_dbconnect\" \"&v_app_owner\" \"&v_pwd\"  \n");
+    } else {
+        fprintf(file, "@'&v_app_home\\\\install\\\\seed_data'          \"&v_dbservice\" \"&v_dbconnect\" \"&v_app_owner\" \"&v_pwd\"  \n");
+    }
     fprintf(file, "@'&v_app_home\\\\install\\\\compile_packages'   \"&v_dbservice\" \"&v_dbconnect\" \"&v_app_owner\" \"&v_pwd\" \"&v_app_home\" \"&v_connect_user\"  \"&v_connect_pwd\" \n");
     fprintf(file, "@'&v_app_home\\\\install\\\\lock_schema'        \"&v_dbservice\" \"&v_dbconnect\" \"&v_app_owner\" \"&v_sys_pwd\" \n");
     fprintf(file, "EXIT\n");
@@ -721,7 +763,10 @@ int main() {
         printf("Script set_env.bat created.\n");
         log_event("Script set_env.bat created.");
         
-        generate_auto_install_sql(dbservice, port, db_connect, app_owner, app_owner_pwd, connect_user, connect_pwd, sql_app_home, sql_data_home, app_home);
+        // Convert the seed data to a bulk load, and use it in place of seed_data.sql if that worked
+        bool fast_seed = generate_seed_load(app_home);
+        
+        generate_auto_install_sql(dbservice, port, db_connect, app_owner, app_owner_pwd, connect_user, connect_pwd, sql_app_home, sql_data_home, app_home, fast_seed);
         printf("SQL Script auto_install.sql created.\n");
         log_event("SQL script auto_install.sql created.");
     